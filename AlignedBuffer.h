@@ -0,0 +1,114 @@
+/* TD-NeuroMap Aligned Buffer
+ * Cache-line aligned float storage for weights and scratch memory
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <utility>
+
+class AlignedBuffer
+{
+public:
+    static constexpr size_t Alignment = 64;
+    static constexpr size_t FloatsPerLine = Alignment / sizeof(float);
+
+    AlignedBuffer()
+        : m_raw(nullptr)
+        , m_data(nullptr)
+        , m_size(0)
+    {
+    }
+
+    explicit AlignedBuffer(size_t size)
+        : AlignedBuffer()
+    {
+        resize(size);
+    }
+
+    AlignedBuffer(const AlignedBuffer& other)
+        : AlignedBuffer()
+    {
+        resize(other.m_size);
+        if (m_size > 0)
+        {
+            std::memcpy(m_data, other.m_data, m_size * sizeof(float));
+        }
+    }
+
+    AlignedBuffer(AlignedBuffer&& other) noexcept
+        : m_raw(other.m_raw)
+        , m_data(other.m_data)
+        , m_size(other.m_size)
+    {
+        other.m_raw = nullptr;
+        other.m_data = nullptr;
+        other.m_size = 0;
+    }
+
+    AlignedBuffer& operator=(AlignedBuffer other) noexcept
+    {
+        std::swap(m_raw, other.m_raw);
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        return *this;
+    }
+
+    ~AlignedBuffer()
+    {
+        std::free(m_raw);
+    }
+
+    // Reallocates only when the size changes; contents are zeroed
+    void resize(size_t size)
+    {
+        if (size != m_size)
+        {
+            std::free(m_raw);
+            m_raw = nullptr;
+            m_data = nullptr;
+            m_size = 0;
+
+            if (size > 0)
+            {
+                m_raw = std::malloc(size * sizeof(float) + Alignment);
+                if (!m_raw)
+                {
+                    throw std::bad_alloc();
+                }
+                uintptr_t addr = reinterpret_cast<uintptr_t>(m_raw);
+                addr = (addr + Alignment - 1) & ~(static_cast<uintptr_t>(Alignment) - 1);
+                m_data = reinterpret_cast<float*>(addr);
+                m_size = size;
+            }
+        }
+
+        if (m_size > 0)
+        {
+            std::memset(m_data, 0, m_size * sizeof(float));
+        }
+    }
+
+    float* data() { return m_data; }
+    const float* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    float& operator[](size_t i) { return m_data[i]; }
+    const float& operator[](size_t i) const { return m_data[i]; }
+
+    // Round a float count up to a whole number of cache lines
+    static size_t padToLine(size_t count)
+    {
+        return (count + FloatsPerLine - 1) / FloatsPerLine * FloatsPerLine;
+    }
+
+private:
+    void* m_raw;
+    float* m_data;
+    size_t m_size;
+};
\ No newline at end of file
@@ -0,0 +1,76 @@
+/* TD-NeuroMap Background Jobs Implementation */
+
+#include "BackgroundJobs.h"
+#include <utility>
+
+BackgroundJobs::BackgroundJobs()
+    : m_stopping(false)
+    , m_pending(0)
+{
+}
+
+BackgroundJobs::~BackgroundJobs()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+void BackgroundJobs::submit(Task work, Task completion)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Job job;
+        job.work = std::move(work);
+        job.completion = std::move(completion);
+        m_queue.push_back(std::move(job));
+        if (!m_thread.joinable())
+        {
+            m_thread = std::thread(&BackgroundJobs::run, this);
+        }
+    }
+    ++m_pending;
+    m_wake.notify_one();
+}
+
+int BackgroundJobs::poll()
+{
+    std::vector<Task> finished;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        finished.swap(m_finished);
+    }
+
+    for (Task& completion : finished)
+    {
+        completion();
+    }
+    m_pending -= static_cast<int>(finished.size());
+    return static_cast<int>(finished.size());
+}
+
+void BackgroundJobs::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;)
+    {
+        m_wake.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+        if (m_queue.empty())
+        {
+            return;
+        }
+
+        Job job = std::move(m_queue.front());
+        m_queue.pop_front();
+        lock.unlock();
+        job.work();
+        lock.lock();
+        m_finished.push_back(std::move(job.completion));
+    }
+}
@@ -0,0 +1,53 @@
+/* TD-NeuroMap Background Jobs
+ * Worker thread that keeps file I/O off the cook thread. Each job pairs
+ * work, run on the worker, with a completion that the owner runs on its
+ * own thread by polling, so results are applied between cooks.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class BackgroundJobs
+{
+public:
+    typedef std::function<void()> Task;
+
+    BackgroundJobs();
+
+    // Finishes the queued work; completions not yet polled are dropped
+    ~BackgroundJobs();
+
+    // 'work' runs on the worker, jobs in submission order, and may only
+    // touch state captured for it; 'completion' runs in a later poll()
+    void submit(Task work, Task completion);
+
+    // Runs the completions of finished jobs in submission order and
+    // returns how many ran
+    int poll();
+
+    // Jobs submitted whose completion has not run yet
+    int getNumPending() const { return m_pending; }
+
+private:
+    struct Job
+    {
+        Task work;
+        Task completion;
+    };
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<Job> m_queue;
+    std::vector<Task> m_finished;
+    bool m_stopping;
+    int m_pending;                  // Only touched by the polling thread
+    std::thread m_thread;           // Started by the first submit()
+
+    void run();
+};
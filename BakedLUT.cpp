@@ -0,0 +1,182 @@
+/* TD-NeuroMap Baked LUT Implementation */
+
+#include "BakedLUT.h"
+#include "AlignedBuffer.h"
+#include <algorithm>
+#include <thread>
+
+namespace
+{
+    // Grid points evaluated per batched forward pass while baking
+    const int BakeChunk = 256;
+}
+
+BakedLUT::BakedLUT()
+    : m_inputDim(0)
+    , m_outputDim(0)
+    , m_resolution(0)
+{
+    std::fill(m_strides, m_strides + MaxInputs, size_t(0));
+    std::fill(m_lower, m_lower + MaxInputs, 0.0f);
+    std::fill(m_cellsPerUnit, m_cellsPerUnit + MaxInputs, 0.0f);
+}
+
+bool BakedLUT::bake(const NeuralNetwork& network, int resolution,
+                    const std::vector<float>& lower, const std::vector<float>& upper,
+                    ActivationPrecision precision, int numThreads, std::string& error)
+{
+    const NetworkArchitecture& arch = network.getArchitecture();
+    if (arch.inputDim < 1 || arch.inputDim > MaxInputs)
+    {
+        error = "LUT baking supports 1-" + std::to_string(MaxInputs) + " input dimensions, model has " +
+                std::to_string(arch.inputDim);
+        return false;
+    }
+    if (resolution < 2)
+    {
+        error = "LUT resolution must be at least 2";
+        return false;
+    }
+    if (lower.size() != static_cast<size_t>(arch.inputDim) || upper.size() != lower.size())
+    {
+        error = "LUT bounds do not match the model's input dimensions";
+        return false;
+    }
+
+    size_t points = 1;
+    for (int d = 0; d < arch.inputDim; ++d)
+    {
+        points *= static_cast<size_t>(resolution);
+        if (points * arch.outputDim > MaxEntries)
+        {
+            error = "LUT of resolution " + std::to_string(resolution) + " over " +
+                    std::to_string(arch.inputDim) + " inputs exceeds " +
+                    std::to_string(MaxEntries * sizeof(float) / (1024 * 1024)) + " MB";
+            return false;
+        }
+    }
+
+    m_inputDim = arch.inputDim;
+    m_outputDim = arch.outputDim;
+    m_resolution = resolution;
+
+    size_t stride = 1;
+    for (int d = 0; d < m_inputDim; ++d)
+    {
+        m_strides[d] = stride;
+        stride *= static_cast<size_t>(resolution);
+
+        float span = upper[d] - lower[d];
+        m_lower[d] = lower[d];
+        m_cellsPerUnit[d] = span > 0.0f ? (resolution - 1) / span : 0.0f;
+    }
+
+    m_table.assign(points * m_outputDim, 0.0f);
+
+    // Workers fill disjoint, chunk-aligned slices of the table
+    size_t chunks = (points + BakeChunk - 1) / BakeChunk;
+    size_t workers = std::max<size_t>(1, std::min<size_t>(static_cast<size_t>(std::max(numThreads, 1)), chunks));
+    size_t chunksPerWorker = (chunks + workers - 1) / workers;
+
+    std::vector<std::thread> threads;
+    for (size_t w = 1; w < workers; ++w)
+    {
+        size_t begin = std::min(points, w * chunksPerWorker * BakeChunk);
+        size_t end = std::min(points, (w + 1) * chunksPerWorker * BakeChunk);
+        threads.emplace_back(&BakedLUT::bakeRange, this, std::cref(network), precision, begin, end);
+    }
+    bakeRange(network, precision, 0, std::min(points, chunksPerWorker * BakeChunk));
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    return true;
+}
+
+void BakedLUT::bakeRange(const NeuralNetwork& network, ActivationPrecision precision, size_t begin, size_t end)
+{
+    AlignedBuffer input(static_cast<size_t>(m_inputDim) * BakeChunk);
+    AlignedBuffer output(static_cast<size_t>(m_outputDim) * BakeChunk);
+    AlignedBuffer scratch(network.getBatchScratchSize());
+    std::vector<const float*> inputChannels(m_inputDim);
+    std::vector<float*> outputChannels(m_outputDim);
+
+    for (int d = 0; d < m_inputDim; ++d)
+        inputChannels[d] = input.data() + static_cast<size_t>(d) * BakeChunk;
+    for (int j = 0; j < m_outputDim; ++j)
+        outputChannels[j] = output.data() + static_cast<size_t>(j) * BakeChunk;
+
+    for (size_t base = begin; base < end; base += BakeChunk)
+    {
+        int count = static_cast<int>(std::min<size_t>(BakeChunk, end - base));
+
+        for (int s = 0; s < count; ++s)
+        {
+            size_t point = base + s;
+            for (int d = 0; d < m_inputDim; ++d)
+            {
+                size_t index = (point / m_strides[d]) % m_resolution;
+                float position = m_cellsPerUnit[d] > 0.0f ? index / m_cellsPerUnit[d] : 0.0f;
+                input.data()[static_cast<size_t>(d) * BakeChunk + s] = m_lower[d] + position;
+            }
+        }
+
+        network.forwardBatch(inputChannels.data(), outputChannels.data(), count, scratch.data(), precision);
+
+        for (int s = 0; s < count; ++s)
+        {
+            float* entry = m_table.data() + (base + s) * m_outputDim;
+            for (int j = 0; j < m_outputDim; ++j)
+                entry[j] = outputChannels[j][s];
+        }
+    }
+}
+
+void BakedLUT::lookupBatch(const float* const* inputs, float* const* outputs, int count) const
+{
+    const int corners = 1 << m_inputDim;
+    const float lastCell = static_cast<float>(m_resolution - 1);
+
+    for (int s = 0; s < count; ++s)
+    {
+        size_t base = 0;
+        float frac[MaxInputs];
+        for (int d = 0; d < m_inputDim; ++d)
+        {
+            // Clamp to the grid; NaN lands on the lower edge
+            float position = (inputs[d][s] - m_lower[d]) * m_cellsPerUnit[d];
+            position = position > 0.0f ? (position < lastCell ? position : lastCell) : 0.0f;
+
+            int cell = std::min(static_cast<int>(position), m_resolution - 2);
+            frac[d] = position - cell;
+            base += cell * m_strides[d];
+        }
+
+        for (int j = 0; j < m_outputDim; ++j)
+            outputs[j][s] = 0.0f;
+
+        for (int corner = 0; corner < corners; ++corner)
+        {
+            float weight = 1.0f;
+            size_t offset = base;
+            for (int d = 0; d < m_inputDim; ++d)
+            {
+                if (corner & (1 << d))
+                {
+                    weight *= frac[d];
+                    offset += m_strides[d];
+                }
+                else
+                {
+                    weight *= 1.0f - frac[d];
+                }
+            }
+
+            const float* entry = m_table.data() + offset * m_outputDim;
+            for (int j = 0; j < m_outputDim; ++j)
+                outputs[j][s] += weight * entry[j];
+        }
+    }
+}
@@ -0,0 +1,52 @@
+/* TD-NeuroMap Baked LUT
+ * A trained network sampled on a regular grid over its input range.
+ * For 1-4 input dimensions, lookups cost 2^inputDim weighted corner reads
+ * regardless of the size of the network that was baked.
+ */
+
+#pragma once
+
+#include "NeuralNetwork.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class BakedLUT
+{
+public:
+    static constexpr int MaxInputs = 4;
+
+    // Upper bound on table entries (grid points * outputs), 64 MB of floats
+    static constexpr size_t MaxEntries = size_t(1) << 24;
+
+    BakedLUT();
+
+    // Samples 'network' on resolution^inputDim points spanning
+    // [lower[d], upper[d]] per input, spread over 'numThreads' workers.
+    // Bounds are in network input space (normalized when normalization is on).
+    // Hidden layers use 'precision' tanh, the precision Run mode passes to
+    // forwardBatch, so the table matches the network it stands in for.
+    bool bake(const NeuralNetwork& network, int resolution,
+              const std::vector<float>& lower, const std::vector<float>& upper,
+              ActivationPrecision precision, int numThreads, std::string& error);
+
+    // Same contract as NeuralNetwork::forwardBatch; inputs outside the baked
+    // range are clamped to its edges
+    void lookupBatch(const float* const* inputs, float* const* outputs, int count) const;
+
+    bool empty() const { return m_table.empty(); }
+    int getResolution() const { return m_resolution; }
+    int getInputDim() const { return m_inputDim; }
+    size_t getMemoryBytes() const { return m_table.size() * sizeof(float); }
+
+private:
+    int m_inputDim;
+    int m_outputDim;
+    int m_resolution;
+    size_t m_strides[MaxInputs];     // Grid points per step along each input
+    float m_lower[MaxInputs];
+    float m_cellsPerUnit[MaxInputs];  // (resolution - 1) / (upper - lower)
+    std::vector<float> m_table;       // [grid point][output], input 0 fastest
+
+    void bakeRange(const NeuralNetwork& network, ActivationPrecision precision, size_t begin, size_t end);
+};
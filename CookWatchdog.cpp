@@ -0,0 +1,62 @@
+/* TD-NeuroMap Cook Watchdog Implementation */
+
+#include "CookWatchdog.h"
+
+CookWatchdog::CookWatchdog()
+    : m_enabled(false)
+    , m_budgetMicros(0.0)
+    , m_degraded(false)
+    , m_cooksSinceProbe(0)
+    , m_overruns(0)
+    , m_lastMicros(0.0)
+    , m_fullPathMicros(0.0)
+{
+}
+
+void CookWatchdog::configure(bool enabled, double budgetMicros)
+{
+    if (!enabled && m_enabled)
+    {
+        m_degraded = false;
+    }
+    m_enabled = enabled;
+    m_budgetMicros = budgetMicros;
+}
+
+bool CookWatchdog::shouldDegrade() const
+{
+    return m_enabled && m_degraded && m_cooksSinceProbe < ProbeInterval;
+}
+
+void CookWatchdog::recordCook(double micros, bool degraded)
+{
+    m_lastMicros = micros;
+    if (!m_enabled)
+    {
+        return;
+    }
+
+    const bool overrun = micros > m_budgetMicros;
+    if (overrun)
+    {
+        ++m_overruns;
+    }
+
+    if (degraded)
+    {
+        ++m_cooksSinceProbe;
+        return;
+    }
+
+    m_fullPathMicros = m_fullPathMicros > 0.0 ? 0.75 * m_fullPathMicros + 0.25 * micros : micros;
+
+    if (overrun)
+    {
+        m_degraded = true;
+    }
+    else if (m_degraded && micros <= m_budgetMicros * RecoverRatio)
+    {
+        m_degraded = false;
+    }
+    m_cooksSinceProbe = 0;
+}
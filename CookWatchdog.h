@@ -0,0 +1,46 @@
+/* TD-NeuroMap Cook Watchdog
+ * Tracks execute() time against a per-node budget. After an overrun the
+ * node runs a cheaper fallback path; every ProbeInterval cooks it tries the
+ * full path again and returns to it once that fits comfortably.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+class CookWatchdog
+{
+public:
+    // Fallback cooks between full-path probes (one second at 60 fps)
+    static constexpr int ProbeInterval = 60;
+
+    // A probe must come in under this fraction of the budget to recover,
+    // so a path hovering at the limit does not flap
+    static constexpr double RecoverRatio = 0.75;
+
+    CookWatchdog();
+
+    void configure(bool enabled, double budgetMicros);
+
+    // Whether the coming cook should take the fallback path
+    bool shouldDegrade() const;
+
+    // Reports a finished cook and whether it ran the fallback path
+    void recordCook(double micros, bool degraded);
+
+    bool isEnabled() const { return m_enabled; }
+    bool isDegraded() const { return m_enabled && m_degraded; }
+    int64_t getOverruns() const { return m_overruns; }
+    double getLastMicros() const { return m_lastMicros; }
+    double getFullPathMicros() const { return m_fullPathMicros; }
+    double getBudgetMicros() const { return m_budgetMicros; }
+
+private:
+    bool m_enabled;
+    double m_budgetMicros;
+    bool m_degraded;
+    int m_cooksSinceProbe;
+    int64_t m_overruns;
+    double m_lastMicros;
+    double m_fullPathMicros;    // Smoothed cost of full-path cooks
+};
@@ -0,0 +1,112 @@
+/* TD-NeuroMap CPU Feature Detection Implementation */
+
+#include "CpuFeatures.h"
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define NEUROMAP_X86 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace
+{
+#ifdef NEUROMAP_X86
+    void cpuid(int leaf, int subleaf, unsigned int regs[4])
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int r[4];
+        __cpuidex(r, leaf, subleaf);
+        for (int i = 0; i < 4; ++i)
+            regs[i] = static_cast<unsigned int>(r[i]);
+#else
+        __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+    }
+
+    unsigned long long xgetbv0()
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        return _xgetbv(0);
+#else
+        unsigned int eax = 0, edx = 0;
+        __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+    }
+#endif
+
+    CpuFeatures detect()
+    {
+        CpuFeatures features;
+
+#ifdef NEUROMAP_X86
+        unsigned int regs[4] = { 0, 0, 0, 0 };
+        cpuid(0, 0, regs);
+        unsigned int maxLeaf = regs[0];
+
+        cpuid(1, 0, regs);
+        features.sse2 = (regs[3] & (1u << 26)) != 0;
+        features.sse41 = (regs[2] & (1u << 19)) != 0;
+        bool fmaBit = (regs[2] & (1u << 12)) != 0;
+        bool osxsave = (regs[2] & (1u << 27)) != 0;
+        bool avxBit = (regs[2] & (1u << 28)) != 0;
+
+        // The OS has to save the wider register state before we may use it
+        unsigned long long xcr0 = osxsave ? xgetbv0() : 0;
+        bool osAvx = (xcr0 & 0x6) == 0x6;
+        bool osAvx512 = (xcr0 & 0xe6) == 0xe6;
+
+        if (maxLeaf >= 7)
+        {
+            cpuid(7, 0, regs);
+            features.avx2 = osAvx && avxBit && (regs[1] & (1u << 5)) != 0;
+            features.avx512f = osAvx512 && (regs[1] & (1u << 16)) != 0;
+            features.avx512bw = features.avx512f && (regs[1] & (1u << 30)) != 0;
+            features.avx512vnni = features.avx512f && (regs[2] & (1u << 11)) != 0;
+        }
+        features.fma = osAvx && fmaBit;
+#elif defined(__aarch64__) || defined(_M_ARM64)
+        features.neon = true;
+#endif
+
+        const char* cap = std::getenv("NEUROMAP_SIMD");
+        if (cap)
+        {
+            if (std::strcmp(cap, "scalar") == 0)
+            {
+                features = CpuFeatures();
+            }
+            else if (std::strcmp(cap, "sse") == 0)
+            {
+                features.avx2 = features.fma = false;
+                features.avx512f = features.avx512bw = features.avx512vnni = false;
+            }
+            else if (std::strcmp(cap, "avx2") == 0)
+            {
+                features.avx512f = features.avx512bw = features.avx512vnni = false;
+            }
+            else if (std::strcmp(cap, "avx512") == 0)
+            {
+                features.avx512vnni = false;
+            }
+        }
+
+        return features;
+    }
+}
+
+namespace CpuInfo
+{
+
+const CpuFeatures& getFeatures()
+{
+    static const CpuFeatures features = detect();
+    return features;
+}
+
+} // namespace CpuInfo
\ No newline at end of file
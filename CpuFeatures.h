@@ -0,0 +1,26 @@
+/* TD-NeuroMap CPU Feature Detection
+ * Runtime query of the SIMD instruction sets available on this machine
+ */
+
+#pragma once
+
+struct CpuFeatures
+{
+    bool sse2 = false;
+    bool sse41 = false;
+    bool avx2 = false;
+    bool fma = false;
+    bool avx512f = false;
+    bool avx512bw = false;
+    bool avx512vnni = false;
+    bool neon = false;
+};
+
+namespace CpuInfo
+{
+    // Detected once on first call. Setting the NEUROMAP_SIMD environment
+    // variable to "scalar", "sse", "avx2" or "avx512" (without VNNI) caps
+    // the reported features, which is useful for validating the fallback
+    // kernels.
+    const CpuFeatures& getFeatures();
+}
\ No newline at end of file
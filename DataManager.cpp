@@ -5,6 +5,23 @@
 #include <algorithm>
 #include <limits>
 #include <cmath>
+#include <utility>
+
+namespace
+{
+    float normalizeValue(float value, float minVal, float maxVal)
+    {
+        if (std::abs(maxVal - minVal) < 1e-6f)
+            return 0.5f; // If range is too small, return middle value
+
+        return (value - minVal) / (maxVal - minVal);
+    }
+
+    float denormalizeValue(float normalizedValue, float minVal, float maxVal)
+    {
+        return normalizedValue * (maxVal - minVal) + minVal;
+    }
+}
 
 DataManager::DataManager()
     : m_normalizationReady(false)
@@ -54,6 +71,14 @@ void DataManager::clearDataset()
     m_normalizationReady = false;
 }
 
+void DataManager::setDataset(std::vector<std::vector<float>> inputs, std::vector<std::vector<float>> outputs)
+{
+    // The bounds stay with the model currently running; entering Train
+    // recalculates them from the new data
+    m_inputData = std::move(inputs);
+    m_outputData = std::move(outputs);
+}
+
 void DataManager::updateNormalization()
 {
     if (m_inputData.empty())
@@ -66,9 +91,22 @@ void DataManager::updateNormalization()
     m_normalizationReady = true;
 }
 
-std::vector<float> DataManager::normalizeInput(const std::vector<float>& input) const
+NormalizationBounds DataManager::getNormalizationBounds() const
 {
-    if (!m_normalizationReady || input.size() != m_inputMin.size())
+    NormalizationBounds bounds;
+    if (m_normalizationReady)
+    {
+        bounds.inputMin = m_inputMin;
+        bounds.inputMax = m_inputMax;
+        bounds.outputMin = m_outputMin;
+        bounds.outputMax = m_outputMax;
+    }
+    return bounds;
+}
+
+std::vector<float> NormalizationBounds::normalizeInput(const std::vector<float>& input) const
+{
+    if (empty() || input.size() != inputMin.size())
     {
         return input; // Return original if normalization not ready
     }
@@ -78,15 +116,15 @@ std::vector<float> DataManager::normalizeInput(const std::vector<float>& input)
 
     for (size_t i = 0; i < input.size(); ++i)
     {
-        normalized.push_back(normalizeValue(input[i], m_inputMin[i], m_inputMax[i]));
+        normalized.push_back(normalizeValue(input[i], inputMin[i], inputMax[i]));
     }
 
     return normalized;
 }
 
-std::vector<float> DataManager::denormalizeOutput(const std::vector<float>& output) const
+std::vector<float> NormalizationBounds::denormalizeOutput(const std::vector<float>& output) const
 {
-    if (!m_normalizationReady || output.size() != m_outputMin.size())
+    if (empty() || output.size() != outputMin.size())
     {
         return output; // Return original if normalization not ready
     }
@@ -96,15 +134,15 @@ std::vector<float> DataManager::denormalizeOutput(const std::vector<float>& outp
 
     for (size_t i = 0; i < output.size(); ++i)
     {
-        denormalized.push_back(denormalizeValue(output[i], m_outputMin[i], m_outputMax[i]));
+        denormalized.push_back(denormalizeValue(output[i], outputMin[i], outputMax[i]));
     }
 
     return denormalized;
 }
 
-std::vector<float> DataManager::normalizeOutput(const std::vector<float>& output) const
+std::vector<float> NormalizationBounds::normalizeOutput(const std::vector<float>& output) const
 {
-    if (!m_normalizationReady || output.size() != m_outputMin.size())
+    if (empty() || output.size() != outputMin.size())
     {
         return output; // Return original if normalization not ready
     }
@@ -114,12 +152,62 @@ std::vector<float> DataManager::normalizeOutput(const std::vector<float>& output
 
     for (size_t i = 0; i < output.size(); ++i)
     {
-        normalized.push_back(normalizeValue(output[i], m_outputMin[i], m_outputMax[i]));
+        normalized.push_back(normalizeValue(output[i], outputMin[i], outputMax[i]));
     }
 
     return normalized;
 }
 
+void NormalizationBounds::normalizeInputChannel(int channel, const float* values, float* normalized, int count) const
+{
+    if (empty() || channel >= static_cast<int>(inputMin.size()))
+    {
+        if (normalized != values)
+        {
+            std::copy(values, values + count, normalized);
+        }
+        return;
+    }
+
+    float minVal = inputMin[channel];
+    float maxVal = inputMax[channel];
+    for (int i = 0; i < count; ++i)
+    {
+        normalized[i] = normalizeValue(values[i], minVal, maxVal);
+    }
+}
+
+void NormalizationBounds::denormalizeOutputChannel(int channel, float* values, int count) const
+{
+    if (empty() || channel >= static_cast<int>(outputMin.size()))
+    {
+        return;
+    }
+
+    float minVal = outputMin[channel];
+    float maxVal = outputMax[channel];
+    for (int i = 0; i < count; ++i)
+    {
+        values[i] = denormalizeValue(values[i], minVal, maxVal);
+    }
+}
+
+float NormalizationBounds::getJacobianScale(int output, int input) const
+{
+    if (empty() || input >= static_cast<int>(inputMin.size()) ||
+        output >= static_cast<int>(outputMin.size()))
+    {
+        return 1.0f;
+    }
+
+    // normalizeValue is constant across a degenerate input range
+    float inputRange = inputMax[input] - inputMin[input];
+    if (std::abs(inputRange) < 1e-6f)
+        return 0.0f;
+
+    return (outputMax[output] - outputMin[output]) / inputRange;
+}
+
 bool DataManager::validateDimensions(const TD::OP_CHOPInput* inputCHOP, const TD::OP_CHOPInput* targetCHOP,
                                     int expectedInputDim, int expectedOutputDim) const
 {
@@ -218,16 +306,3 @@ void DataManager::calculateNormalizationParams()
         }
     }
 }
-
-float DataManager::normalizeValue(float value, float minVal, float maxVal) const
-{
-    if (std::abs(maxVal - minVal) < 1e-6f)
-        return 0.5f; // If range is too small, return middle value
-
-    return (value - minVal) / (maxVal - minVal);
-}
-
-float DataManager::denormalizeValue(float normalizedValue, float minVal, float maxVal) const
-{
-    return normalizedValue * (maxVal - minVal) + minVal;
-}
\ No newline at end of file
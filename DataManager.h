@@ -12,6 +12,30 @@ namespace TD {
     class OP_CHOPInput;
 }
 
+// Per-dimension min/max ranges, as stored alongside a trained model
+struct NormalizationBounds
+{
+    std::vector<float> inputMin, inputMax;
+    std::vector<float> outputMin, outputMax;
+
+    bool empty() const { return inputMin.empty() || outputMin.empty(); }
+
+    // Each pass returns its input unchanged when the bounds are empty or
+    // do not cover it
+    std::vector<float> normalizeInput(const std::vector<float>& input) const;
+    std::vector<float> denormalizeOutput(const std::vector<float>& output) const;
+    std::vector<float> normalizeOutput(const std::vector<float>& output) const; // For training
+
+    // Channel-wise, allocation-free variants for inference; normalizeInputChannel
+    // may run in place (values == normalized)
+    void normalizeInputChannel(int channel, const float* values, float* normalized, int count) const;
+    void denormalizeOutputChannel(int channel, float* values, int count) const;
+
+    // Factor taking d(network output)/d(network input) to raw units:
+    // output range / input range, or 1 without normalization
+    float getJacobianScale(int output, int input) const;
+};
+
 class DataManager
 {
 public:
@@ -22,6 +46,8 @@ public:
     bool addSample(const TD::OP_CHOPInput* inputCHOP, const TD::OP_CHOPInput* targetCHOP, 
                    int inputDim, int outputDim);
     void clearDataset();
+    // Replaces every recorded pair, as when loading a saved dataset
+    void setDataset(std::vector<std::vector<float>> inputs, std::vector<std::vector<float>> outputs);
     int getDatasetSize() const { return static_cast<int>(m_inputData.size()); }
 
     // Data Access
@@ -31,10 +57,7 @@ public:
     // Normalization
     void updateNormalization();
     bool isNormalizationReady() const { return m_normalizationReady; }
-    
-    std::vector<float> normalizeInput(const std::vector<float>& input) const;
-    std::vector<float> denormalizeOutput(const std::vector<float>& output) const;
-    std::vector<float> normalizeOutput(const std::vector<float>& output) const; // For training
+    NormalizationBounds getNormalizationBounds() const;
 
     // Data validation
     bool validateDimensions(const TD::OP_CHOPInput* inputCHOP, const TD::OP_CHOPInput* targetCHOP,
@@ -53,6 +76,4 @@ private:
     // Helper methods
     std::vector<float> extractChannelData(const TD::OP_CHOPInput* chop, int maxChannels) const;
     void calculateNormalizationParams();
-    float normalizeValue(float value, float minVal, float maxVal) const;
-    float denormalizeValue(float normalizedValue, float minVal, float maxVal) const;
 };
\ No newline at end of file
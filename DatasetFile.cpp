@@ -0,0 +1,165 @@
+/* TD-NeuroMap Dataset File Implementation
+ *
+ * Layout (native little-endian):
+ *   0   char[4]  magic "NMDS"
+ *   4   uint32   version
+ *   8   uint64   checksum of bytes [16, end of file)   (ModelFile::checksum)
+ *   16  int32    inputDim, outputDim
+ *   24  uint64   count
+ *   32  uint64   inputsOffset, targetsOffset           (multiples of 64)
+ *   inputsOffset:   float inputs[count][inputDim]
+ *   targetsOffset:  float targets[count][outputDim]
+ */
+
+#include "DatasetFile.h"
+#include "MappedFile.h"
+#include "ModelFile.h"
+#include "AlignedBuffer.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    const char Magic[4] = { 'N', 'M', 'D', 'S' };
+    const uint32_t Version = 1;
+    const size_t ChecksumOffset = 8;
+    const size_t ChecksummedOffset = 16;
+    const size_t HeaderSize = 48;
+    const int MaxDim = 4096;
+
+    size_t alignOffset(size_t offset)
+    {
+        return (offset + AlignedBuffer::Alignment - 1) / AlignedBuffer::Alignment * AlignedBuffer::Alignment;
+    }
+
+    template <typename T>
+    void writeAt(std::vector<char>& out, size_t offset, const T& value)
+    {
+        std::memcpy(out.data() + offset, &value, sizeof(T));
+    }
+
+    template <typename T>
+    T readAt(const char* data, size_t offset)
+    {
+        T value;
+        std::memcpy(&value, data + offset, sizeof(T));
+        return value;
+    }
+
+    bool matches(const std::vector<float>& input, const std::vector<float>& target, int inputDim, int outputDim)
+    {
+        return input.size() == static_cast<size_t>(inputDim) && target.size() == static_cast<size_t>(outputDim);
+    }
+}
+
+namespace DatasetFile
+{
+
+int serialize(const Samples& inputs, const Samples& targets, int inputDim, int outputDim,
+              std::vector<char>& out)
+{
+    const size_t numPairs = std::min(inputs.size(), targets.size());
+    size_t count = 0;
+    for (size_t i = 0; i < numPairs; ++i)
+    {
+        if (matches(inputs[i], targets[i], inputDim, outputDim))
+            ++count;
+    }
+
+    const size_t inputsOffset = alignOffset(HeaderSize);
+    const size_t targetsOffset = alignOffset(inputsOffset + count * inputDim * sizeof(float));
+    out.assign(targetsOffset + count * outputDim * sizeof(float), 0);
+
+    std::memcpy(out.data(), Magic, sizeof(Magic));
+    writeAt(out, 4, Version);
+    writeAt(out, 16, static_cast<int32_t>(inputDim));
+    writeAt(out, 20, static_cast<int32_t>(outputDim));
+    writeAt(out, 24, static_cast<uint64_t>(count));
+    writeAt(out, 32, static_cast<uint64_t>(inputsOffset));
+    writeAt(out, 40, static_cast<uint64_t>(targetsOffset));
+
+    char* inputRows = out.data() + inputsOffset;
+    char* targetRows = out.data() + targetsOffset;
+    for (size_t i = 0; i < numPairs; ++i)
+    {
+        if (!matches(inputs[i], targets[i], inputDim, outputDim))
+            continue;
+        std::memcpy(inputRows, inputs[i].data(), inputDim * sizeof(float));
+        std::memcpy(targetRows, targets[i].data(), outputDim * sizeof(float));
+        inputRows += inputDim * sizeof(float);
+        targetRows += outputDim * sizeof(float);
+    }
+
+    const uint64_t checksum = ModelFile::checksum(out.data() + ChecksummedOffset, out.size() - ChecksummedOffset);
+    writeAt(out, ChecksumOffset, checksum);
+    return static_cast<int>(count);
+}
+
+bool save(const std::string& path, const Samples& inputs, const Samples& targets,
+          int inputDim, int outputDim, int& numSaved, std::string& error)
+{
+    std::vector<char> bytes;
+    numSaved = serialize(inputs, targets, inputDim, outputDim, bytes);
+    return ModelFile::writeBytes(path, bytes, error);
+}
+
+bool parse(const char* data, size_t size, Samples& inputs, Samples& targets, std::string& error)
+{
+    if (size < HeaderSize || std::memcmp(data, Magic, sizeof(Magic)) != 0)
+    {
+        error = "Not a NeuroMap dataset file";
+        return false;
+    }
+    const uint32_t version = readAt<uint32_t>(data, 4);
+    if (version != Version)
+    {
+        error = "Unsupported dataset file version " + std::to_string(version);
+        return false;
+    }
+    const uint64_t checksum = ModelFile::checksum(data + ChecksummedOffset, size - ChecksummedOffset);
+    if (readAt<uint64_t>(data, ChecksumOffset) != checksum)
+    {
+        error = "Dataset file is corrupt (checksum mismatch)";
+        return false;
+    }
+
+    const int32_t inputDim = readAt<int32_t>(data, 16);
+    const int32_t outputDim = readAt<int32_t>(data, 20);
+    const uint64_t count = readAt<uint64_t>(data, 24);
+    const uint64_t inputsOffset = readAt<uint64_t>(data, 32);
+    const uint64_t targetsOffset = readAt<uint64_t>(data, 40);
+    if (inputDim < 1 || outputDim < 1 || inputDim > MaxDim || outputDim > MaxDim ||
+        inputsOffset > size || targetsOffset > size ||
+        count > (size - inputsOffset) / (inputDim * sizeof(float)) ||
+        count > (size - targetsOffset) / (outputDim * sizeof(float)))
+    {
+        error = "Invalid dataset layout";
+        return false;
+    }
+
+    const char* inputRows = data + inputsOffset;
+    const char* targetRows = data + targetsOffset;
+    inputs.resize(static_cast<size_t>(count));
+    targets.resize(static_cast<size_t>(count));
+    for (size_t i = 0; i < count; ++i)
+    {
+        inputs[i].resize(inputDim);
+        targets[i].resize(outputDim);
+        std::memcpy(inputs[i].data(), inputRows + i * inputDim * sizeof(float), inputDim * sizeof(float));
+        std::memcpy(targets[i].data(), targetRows + i * outputDim * sizeof(float), outputDim * sizeof(float));
+    }
+    return true;
+}
+
+bool load(const std::string& path, Samples& inputs, Samples& targets, std::string& error)
+{
+    std::shared_ptr<MappedFile> file = MappedFile::open(path, error);
+    return file && parse(file->data(), file->size(), inputs, targets, error);
+}
+
+uint64_t contentHash(const char* data, size_t size)
+{
+    return size < HeaderSize ? 0 : readAt<uint64_t>(data, ChecksumOffset);
+}
+
+} // namespace DatasetFile
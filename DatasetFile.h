@@ -0,0 +1,33 @@
+/* TD-NeuroMap Dataset File
+ * Binary storage of recorded input/target pairs, in the style of the model
+ * file: checksummed header, then the inputs and the targets as 64-byte
+ * aligned [sample][dimension] blocks.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace DatasetFile
+{
+    typedef std::vector<std::vector<float>> Samples;   // [sample][dimension]
+
+    // Writes the pairs whose sizes are inputDim and outputDim and returns
+    // how many; pairs recorded with other dimensions are left out
+    int serialize(const Samples& inputs, const Samples& targets, int inputDim, int outputDim,
+                  std::vector<char>& out);
+
+    bool save(const std::string& path, const Samples& inputs, const Samples& targets,
+              int inputDim, int outputDim, int& numSaved, std::string& error);
+
+    // Returns false and sets 'error' if the data is not a valid dataset
+    bool parse(const char* data, size_t size, Samples& inputs, Samples& targets, std::string& error);
+
+    bool load(const std::string& path, Samples& inputs, Samples& targets, std::string& error);
+
+    // The stored checksum, identifying a dataset's contents without
+    // reading them; 0 if the data is too short to be a dataset
+    uint64_t contentHash(const char* data, size_t size);
+}
@@ -0,0 +1,164 @@
+/* TD-NeuroMap File Watcher Implementation */
+
+#include "FileWatcher.h"
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+FileWatcher::FileWatcher()
+    : m_notifyFd(-1)
+    , m_watchFd(-1)
+{
+}
+
+FileWatcher::~FileWatcher()
+{
+    closeNotifications();
+}
+
+void FileWatcher::watch(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    closeNotifications();
+    m_path = path;
+    m_seen = Stamp();
+    if (m_path.empty())
+    {
+        return;
+    }
+
+    size_t slash = m_path.find_last_of("/\\");
+    m_fileName = slash == std::string::npos ? m_path : m_path.substr(slash + 1);
+
+#ifdef __linux__
+    // Watch the directory: a file replaced by rename is a new inode, which
+    // a watch on the file itself would miss
+    std::string directory = slash == std::string::npos ? "." : m_path.substr(0, slash + 1);
+    m_notifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_notifyFd >= 0)
+    {
+        m_watchFd = inotify_add_watch(m_notifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (m_watchFd < 0)
+        {
+            closeNotifications();
+        }
+    }
+#endif
+
+    m_seen = readStamp();
+}
+
+std::string FileWatcher::getPath()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_path;
+}
+
+bool FileWatcher::poll()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_path.empty())
+    {
+        return false;
+    }
+
+    // With notifications the file is only looked at after a completed
+    // write or rename of it
+    if (m_notifyFd >= 0 && !drainEvents())
+    {
+        return false;
+    }
+
+    Stamp current = readStamp();
+    if (current == m_seen)
+    {
+        return false;
+    }
+    m_seen = current;
+    return current.exists;
+}
+
+void FileWatcher::markSeen()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_notifyFd >= 0)
+    {
+        drainEvents();
+    }
+    m_seen = readStamp();
+}
+
+bool FileWatcher::usesNotifications()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_notifyFd >= 0;
+}
+
+FileWatcher::Stamp FileWatcher::readStamp() const
+{
+    Stamp stamp;
+#ifdef _WIN32
+    struct _stat64 info;
+    if (_stat64(m_path.c_str(), &info) != 0)
+    {
+        return stamp;
+    }
+    stamp.modified = static_cast<int64_t>(info.st_mtime) * 1000000000;
+#else
+    struct stat info;
+    if (stat(m_path.c_str(), &info) != 0)
+    {
+        return stamp;
+    }
+#ifdef __APPLE__
+    stamp.modified = static_cast<int64_t>(info.st_mtimespec.tv_sec) * 1000000000 + info.st_mtimespec.tv_nsec;
+#else
+    stamp.modified = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+#endif
+#endif
+    stamp.exists = true;
+    stamp.size = static_cast<uint64_t>(info.st_size);
+    return stamp;
+}
+
+bool FileWatcher::drainEvents()
+{
+    bool matched = false;
+#ifdef __linux__
+    alignas(struct inotify_event) char buffer[4096];
+    for (;;)
+    {
+        ssize_t length = read(m_notifyFd, buffer, sizeof(buffer));
+        if (length <= 0)
+        {
+            break;
+        }
+        for (ssize_t pos = 0; pos < length;)
+        {
+            const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(buffer + pos);
+            if (event->len > 0 && m_fileName == event->name)
+            {
+                matched = true;
+            }
+            pos += static_cast<ssize_t>(sizeof(struct inotify_event) + event->len);
+        }
+    }
+#endif
+    return matched;
+}
+
+void FileWatcher::closeNotifications()
+{
+#ifdef __linux__
+    if (m_notifyFd >= 0)
+    {
+        close(m_notifyFd);
+    }
+#endif
+    m_notifyFd = -1;
+    m_watchFd = -1;
+}
@@ -0,0 +1,58 @@
+/* TD-NeuroMap File Watcher
+ * Reports when a file has been rewritten. Linux uses inotify on the
+ * file's directory, which also sees files replaced by a rename; other
+ * platforms compare the modification time and size on every poll.
+ * Thread-safe, so background jobs can poll it.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+class FileWatcher
+{
+public:
+    FileWatcher();
+    ~FileWatcher();
+
+    // Starts watching 'path', or stops for an empty path. The file as it
+    // is now counts as seen.
+    void watch(const std::string& path);
+    std::string getPath();
+
+    // Whether the file changed since it was last seen; the change then
+    // counts as seen. A deleted file is not reported.
+    bool poll();
+
+    // Takes the file as it is now as seen, e.g. after writing it ourselves
+    void markSeen();
+
+    // inotify is available and watching
+    bool usesNotifications();
+
+private:
+    struct Stamp
+    {
+        bool exists = false;
+        int64_t modified = 0;       // Nanoseconds, as precise as the platform reports
+        uint64_t size = 0;
+
+        bool operator==(const Stamp& other) const
+        {
+            return exists == other.exists && modified == other.modified && size == other.size;
+        }
+    };
+
+    std::mutex m_mutex;
+    std::string m_path;
+    std::string m_fileName;         // The part of m_path inotify reports
+    Stamp m_seen;
+    int m_notifyFd;                 // inotify instance, -1 when polling
+    int m_watchFd;
+
+    Stamp readStamp() const;
+    bool drainEvents();
+    void closeNotifications();
+};
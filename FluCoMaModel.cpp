@@ -0,0 +1,269 @@
+/* TD-NeuroMap FluCoMa Model Implementation */
+
+#include "FluCoMaModel.h"
+#include "JsonStream.h"
+#include "ModelFile.h"
+#include "NormalizationFold.h"
+#include <algorithm>
+#include <cctype>
+
+namespace
+{
+    struct LayerShape
+    {
+        int activation = -1;
+        int rows = 0;
+        int cols = 0;
+    };
+
+    // Walks {"layers":[...]}. Without a target only the shapes are read and
+    // the arrays skipped; with one, biases and weights are written into it
+    // in NeuralNetwork's [output][input] layout.
+    bool readLayers(JsonReader& reader, std::vector<LayerShape>& shapes, NeuralNetwork* target,
+                    std::string& error)
+    {
+        std::string key;
+        bool foundLayers = false;
+        if (!reader.beginObject())
+        {
+            error = "Expected a JSON object";
+            return false;
+        }
+
+        while (reader.nextKey(key))
+        {
+            if (key != "layers")
+            {
+                reader.skipValue();
+                continue;
+            }
+
+            foundLayers = true;
+            reader.beginArray();
+            for (size_t l = 0; reader.nextElement(); ++l)
+            {
+                if (!target)
+                    shapes.emplace_back();
+                else if (l >= shapes.size())
+                    break;
+                LayerShape& shape = shapes[l];
+                const std::string layerName = "Layer " + std::to_string(l);
+
+                reader.beginObject();
+                while (reader.nextKey(key))
+                {
+                    if (!target && key == "activation")
+                    {
+                        reader.readInt(shape.activation);
+                    }
+                    else if (!target && key == "rows")
+                    {
+                        reader.readInt(shape.rows);
+                    }
+                    else if (!target && key == "cols")
+                    {
+                        reader.readInt(shape.cols);
+                    }
+                    else if (target && key == "biases")
+                    {
+                        float* bias = target->getLayerBias(static_cast<int>(l));
+                        int count = 0;
+                        reader.beginArray();
+                        for (; reader.nextElement(); ++count)
+                        {
+                            float ignored;
+                            reader.readFloat(count < shape.cols ? bias[count] : ignored);
+                        }
+                        if (!reader.failed() && count != shape.cols)
+                        {
+                            error = layerName + " has " + std::to_string(count) + " biases, expected " +
+                                    std::to_string(shape.cols);
+                            return false;
+                        }
+                    }
+                    else if (target && key == "weights")
+                    {
+                        // FluCoMa rows are inputs; ours are outputs
+                        float* weights = target->getLayerWeights(static_cast<int>(l));
+                        int row = 0;
+                        bool sizesMatch = true;
+                        reader.beginArray();
+                        for (; reader.nextElement(); ++row)
+                        {
+                            int col = 0;
+                            reader.beginArray();
+                            for (; reader.nextElement(); ++col)
+                            {
+                                float ignored;
+                                const bool inRange = row < shape.rows && col < shape.cols;
+                                reader.readFloat(inRange ? weights[col * shape.rows + row] : ignored);
+                            }
+                            sizesMatch = sizesMatch && col == shape.cols;
+                        }
+                        if (!reader.failed() && (!sizesMatch || row != shape.rows))
+                        {
+                            error = layerName + " weights are not " + std::to_string(shape.rows) + " x " +
+                                    std::to_string(shape.cols);
+                            return false;
+                        }
+                    }
+                    else
+                    {
+                        reader.skipValue();
+                    }
+                }
+            }
+        }
+
+        if (reader.failed() || !reader.atEnd())
+        {
+            error = "Malformed JSON near byte " + std::to_string(reader.getPosition());
+            return false;
+        }
+        if (!foundLayers)
+        {
+            error = "No \"layers\" in the JSON model";
+            return false;
+        }
+        return true;
+    }
+
+    bool toArchitecture(const std::vector<LayerShape>& shapes, NetworkArchitecture& arch, std::string& error)
+    {
+        if (shapes.size() < 2)
+        {
+            error = "The JSON model needs at least one hidden layer";
+            return false;
+        }
+
+        arch.inputDim = shapes.front().rows;
+        arch.outputDim = shapes.back().cols;
+        arch.hiddenUnits = shapes.front().cols;
+        arch.hiddenLayers = static_cast<int>(shapes.size()) - 1;
+        for (size_t l = 0; l < shapes.size(); ++l)
+        {
+            const LayerShape& shape = shapes[l];
+            const bool isOutput = l + 1 == shapes.size();
+            const FluCoMaModel::Activation expected =
+                isOutput ? FluCoMaModel::Activation::Identity : FluCoMaModel::Activation::Tanh;
+            if (shape.activation != static_cast<int>(expected))
+            {
+                error = "Layer " + std::to_string(l) + (isOutput ? " must use identity" : " must use tanh") +
+                        " activation";
+                return false;
+            }
+            if ((l > 0 && shape.rows != shapes[l - 1].cols) || (!isOutput && shape.cols != arch.hiddenUnits))
+            {
+                error = "Hidden layers must all have " + std::to_string(arch.hiddenUnits) + " units";
+                return false;
+            }
+        }
+
+        if (!ModelFile::isValidArchitecture(arch))
+        {
+            error = "Invalid model architecture";
+            return false;
+        }
+        return true;
+    }
+}
+
+namespace FluCoMaModel
+{
+
+bool hasJsonExtension(const std::string& path)
+{
+    const std::string extension = ".json";
+    if (path.size() < extension.size())
+        return false;
+    return std::equal(extension.begin(), extension.end(), path.end() - extension.size(),
+                      [](char a, char b) { return a == std::tolower(static_cast<unsigned char>(b)); });
+}
+
+bool isJson(const char* data, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (!std::isspace(static_cast<unsigned char>(data[i])))
+            return data[i] == '{';
+    }
+    return false;
+}
+
+void serialize(const NeuralNetwork& network, const NormalizationBounds& normalization,
+               std::vector<char>& out)
+{
+    std::shared_ptr<const NeuralNetwork> folded = NormalizationFold::makeFolded(network, normalization);
+    const NeuralNetwork& source = folded ? *folded : network;
+
+    out.clear();
+    out.reserve(64 + source.getStorageSize() * 12);
+    JsonWriter writer(out);
+    writer.beginObject();
+    writer.key("layers");
+    writer.beginArray();
+    const DenseLayer* layers = source.getLayers();
+    for (int l = 0; l < source.getNumLayers(); ++l)
+    {
+        const DenseLayer& layer = layers[l];
+        const bool isOutput = l == source.getNumLayers() - 1;
+        writer.beginObject();
+        writer.key("activation");
+        writer.value(static_cast<int>(isOutput ? Activation::Identity : Activation::Tanh));
+        writer.key("biases");
+        writer.beginArray();
+        for (int j = 0; j < layer.outputs; ++j)
+        {
+            writer.value(layer.bias[j]);
+        }
+        writer.endArray();
+        writer.key("cols");
+        writer.value(layer.outputs);
+        writer.key("rows");
+        writer.value(layer.inputs);
+        writer.key("weights");
+        writer.beginArray();
+        for (int k = 0; k < layer.inputs; ++k)
+        {
+            writer.beginArray();
+            for (int j = 0; j < layer.outputs; ++j)
+            {
+                writer.value(layer.weights[j * layer.inputs + k]);
+            }
+            writer.endArray();
+        }
+        writer.endArray();
+        writer.endObject();
+    }
+    writer.endArray();
+    writer.endObject();
+}
+
+std::unique_ptr<NeuralNetwork> parse(const char* data, size_t size, std::string& error)
+{
+    // Shapes first, so the second pass can write every number into its
+    // final place in the allocated network
+    std::vector<LayerShape> shapes;
+    JsonReader shapeReader(data, size);
+    if (!readLayers(shapeReader, shapes, nullptr, error))
+    {
+        return nullptr;
+    }
+
+    NetworkArchitecture arch;
+    if (!toArchitecture(shapes, arch, error))
+    {
+        return nullptr;
+    }
+
+    std::unique_ptr<NeuralNetwork> network(new NeuralNetwork(arch));
+    JsonReader weightReader(data, size);
+    if (!readLayers(weightReader, shapes, network.get(), error))
+    {
+        return nullptr;
+    }
+    network->updateKernelWeights();
+    return network;
+}
+
+} // namespace FluCoMaModel
@@ -0,0 +1,46 @@
+/* TD-NeuroMap FluCoMa Model
+ * Reads and writes the MLP JSON of FluCoMa's fluid.mlpregressor~:
+ *
+ *   {"layers":[{"activation":3,"biases":[...],"cols":64,"rows":2,
+ *               "weights":[[...], ...]}, ...]}
+ *
+ * 'rows' is a layer's input count and 'cols' its output count, with
+ * weights[row][col]. Numbers stream straight between the text and the
+ * network's weight storage; no document tree is built.
+ */
+
+#pragma once
+
+#include "NeuralNetwork.h"
+#include "DataManager.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace FluCoMaModel
+{
+    // FluCoMa's activation numbering
+    enum class Activation
+    {
+        Identity = 0,
+        Sigmoid = 1,
+        ReLU = 2,
+        Tanh = 3
+    };
+
+    // Whether 'path' names a JSON file, which saves in this format
+    bool hasJsonExtension(const std::string& path);
+
+    // Whether the data is JSON rather than a binary model file
+    bool isJson(const char* data, size_t size);
+
+    // FluCoMa keeps normalization in a separate object, so a model with
+    // normalization is written with the bounds folded into its weights
+    // and maps raw inputs to raw outputs on its own
+    void serialize(const NeuralNetwork& network, const NormalizationBounds& normalization,
+                   std::vector<char>& out);
+
+    // Returns the network, or nullptr and sets 'error'. Only tanh hidden
+    // layers of one width and an identity output layer can be imported.
+    std::unique_ptr<NeuralNetwork> parse(const char* data, size_t size, std::string& error);
+}
@@ -0,0 +1,151 @@
+/* TD-NeuroMap Inference Kernels Implementation */
+
+#include "InferenceKernels.h"
+#include <cmath>
+
+namespace InferenceKernels
+{
+
+DenseLayer packColumns(const DenseLayer& layer, float* packed)
+{
+    const int stride = columnStride(layer.outputs);
+    float* weights = packed;
+    float* bias = packed + static_cast<size_t>(layer.inputs) * stride;
+    for (int k = 0; k < layer.inputs; ++k)
+    {
+        float* column = weights + static_cast<size_t>(k) * stride;
+        for (int j = 0; j < stride; ++j)
+        {
+            column[j] = j < layer.outputs ? layer.weights[j * layer.inputs + k] : 0.0f;
+        }
+    }
+    for (int j = 0; j < stride; ++j)
+    {
+        bias[j] = j < layer.outputs ? layer.bias[j] : 0.0f;
+    }
+
+    DenseLayer view = { layer.inputs, layer.outputs, weights, bias };
+    return view;
+}
+
+void forwardGeneric(const DenseLayer* layers, int numLayers, const float* input, float* output,
+                    float* scratch, ActivationPrecision precision)
+{
+    // The output layer writes straight into 'output', so only hidden
+    // layers need scratch space
+    int widest = 0;
+    for (int l = 0; l < numLayers - 1; ++l)
+    {
+        if (layers[l].outputs > widest)
+            widest = layers[l].outputs;
+    }
+
+    const float* x = input;
+    float* current = scratch;
+    float* next = scratch + widest;
+
+    for (int l = 0; l < numLayers; ++l)
+    {
+        const DenseLayer& layer = layers[l];
+        bool isOutput = (l == numLayers - 1);
+        float* y = isOutput ? output : current;
+
+        for (int j = 0; j < layer.outputs; ++j)
+        {
+            const float* row = layer.weights + j * layer.inputs;
+            float acc = layer.bias[j];
+            for (int k = 0; k < layer.inputs; ++k)
+            {
+                acc += row[k] * x[k];
+            }
+            y[j] = isOutput ? acc : tanh(acc, precision);
+        }
+
+        x = y;
+        float* tmp = current;
+        current = next;
+        next = tmp;
+    }
+}
+
+void forwardJacobian(const DenseLayer* layers, int numLayers, const float* input, float* output,
+                     float* jacobian, float* scratch, ActivationPrecision precision)
+{
+    const int n = layers[0].inputs;
+    int widest = 0;
+    for (int l = 0; l < numLayers - 1; ++l)
+    {
+        if (layers[l].outputs > widest)
+            widest = layers[l].outputs;
+    }
+
+    // Each buffer holds activations [widest] followed by their tangents
+    // [widest][n]; the input's tangent is the identity and is never stored
+    const size_t stride = static_cast<size_t>(widest) * (n + 1);
+    float* current = scratch;
+    float* next = scratch + stride;
+
+    const float* x = input;
+    const float* dx = nullptr;
+
+    for (int l = 0; l < numLayers; ++l)
+    {
+        const DenseLayer& layer = layers[l];
+        bool isOutput = (l == numLayers - 1);
+        float* y = isOutput ? output : current;
+        float* dy = isOutput ? jacobian : current + widest;
+
+        for (int j = 0; j < layer.outputs; ++j)
+        {
+            // One sweep over the weight row updates the value and all tangents
+            const float* row = layer.weights + j * layer.inputs;
+            float* dyj = dy + static_cast<size_t>(j) * n;
+            float acc = layer.bias[j];
+            for (int t = 0; t < n; ++t)
+            {
+                dyj[t] = 0.0f;
+            }
+
+            for (int k = 0; k < layer.inputs; ++k)
+            {
+                float w = row[k];
+                acc += w * x[k];
+                if (dx)
+                {
+                    const float* dxk = dx + static_cast<size_t>(k) * n;
+                    for (int t = 0; t < n; ++t)
+                    {
+                        dyj[t] += w * dxk[t];
+                    }
+                }
+                else
+                {
+                    dyj[k] = w;
+                }
+            }
+
+            if (isOutput)
+            {
+                y[j] = acc;
+            }
+            else
+            {
+                float h = tanh(acc, precision);
+                float slope = 1.0f - h * h;
+                for (int t = 0; t < n; ++t)
+                {
+                    dyj[t] *= slope;
+                }
+                y[j] = h;
+            }
+        }
+
+        x = y;
+        dx = dy;
+        float* tmp = current;
+        current = next;
+        next = tmp;
+    }
+}
+
+} // namespace InferenceKernels
\ No newline at end of file
@@ -0,0 +1,113 @@
+/* TD-NeuroMap Inference Kernels
+ * Forward-pass kernels for the multi-layer perceptron.
+ * Small common shapes have compile-time specialized kernels
+ * (SimdKernels::getForwardKernel), which run on a column-major copy of the
+ * weights; every other shape takes the generic runtime-sized path.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+// View of one fully connected layer inside a network's weight storage.
+// Weights are row-major [outputs][inputs].
+struct DenseLayer
+{
+    int inputs;
+    int outputs;
+    const float* weights;
+    const float* bias;
+};
+
+// How hidden-layer tanh is evaluated. Fast is a clamped [13/6] rational
+// approximation, within InferenceKernels::TanhMaxError of tanh, that
+// vectorizes and is fused with the bias add inside the layer kernels.
+// Exact calls std::tanh.
+enum class ActivationPrecision
+{
+    Exact = 0,
+    Fast = 1
+};
+
+// Evaluates one input vector through all layers. Hidden layers use tanh,
+// the output layer is linear. 'layers' are column-major views written by
+// InferenceKernels::packColumns; 'scratch' is unused.
+typedef void (*ForwardKernelFn)(const DenseLayer* layers, int numLayers,
+                                const float* input, float* output, float* scratch);
+
+namespace InferenceKernels
+{
+    // Coefficients of the Fast tanh; the SIMD kernels use the same ones
+    constexpr float TanhClamp = 7.90531110763549805f;
+    constexpr float TanhAlpha1 = 4.89352455891786e-03f;
+    constexpr float TanhAlpha3 = 6.37261928875436e-04f;
+    constexpr float TanhAlpha5 = 1.48572235717979e-05f;
+    constexpr float TanhAlpha7 = 5.12229709037114e-08f;
+    constexpr float TanhAlpha9 = -8.60467152213735e-11f;
+    constexpr float TanhAlpha11 = 2.00018790482477e-13f;
+    constexpr float TanhAlpha13 = -2.76076847742355e-16f;
+    constexpr float TanhBeta0 = 4.89352518554385e-03f;
+    constexpr float TanhBeta2 = 2.26843463243900e-03f;
+    constexpr float TanhBeta4 = 1.18534705686654e-04f;
+    constexpr float TanhBeta6 = 1.19825839466702e-06f;
+
+    // Bound on |fastTanh(x) - tanh(x)| over every float, for the scalar
+    // form and the SIMD kernels; the largest measured is 4.10e-7, near
+    // |x| = 5.83. tests/FastTanhTest checks it.
+    constexpr float TanhMaxError = 4.2e-7f;
+
+    inline float fastTanh(float x)
+    {
+        x = x < -TanhClamp ? -TanhClamp : (x > TanhClamp ? TanhClamp : x);
+        const float x2 = x * x;
+        float p = TanhAlpha13;
+        p = p * x2 + TanhAlpha11;
+        p = p * x2 + TanhAlpha9;
+        p = p * x2 + TanhAlpha7;
+        p = p * x2 + TanhAlpha5;
+        p = p * x2 + TanhAlpha3;
+        p = p * x2 + TanhAlpha1;
+        float q = TanhBeta6;
+        q = q * x2 + TanhBeta4;
+        q = q * x2 + TanhBeta2;
+        q = q * x2 + TanhBeta0;
+        return x * p / q;
+    }
+
+    inline float tanh(float x, ActivationPrecision precision)
+    {
+        return precision == ActivationPrecision::Fast ? fastTanh(x) : std::tanh(x);
+    }
+
+    // Column-major layers hold [inputs][columnStride(outputs)] weights and
+    // columnStride(outputs) biases, zero beyond 'outputs', so every column
+    // is whole 64-byte vectors
+    constexpr int ColumnAlign = 16;
+
+    constexpr int columnStride(int outputs)
+    {
+        return (outputs + ColumnAlign - 1) / ColumnAlign * ColumnAlign;
+    }
+
+    // Floats packColumns writes for 'layer'
+    inline size_t getColumnSize(const DenseLayer& layer)
+    {
+        return static_cast<size_t>(layer.inputs + 1) * columnStride(layer.outputs);
+    }
+
+    // Writes the column-major form of row-major 'layer' to 'packed'
+    // (64-byte aligned, getColumnSize(layer) floats) and returns its view
+    DenseLayer packColumns(const DenseLayer& layer, float* packed);
+
+    // Runtime-sized fallback
+    void forwardGeneric(const DenseLayer* layers, int numLayers, const float* input, float* output,
+                        float* scratch, ActivationPrecision precision);
+
+    // Forward pass that also carries d(activation)/d(input) alongside every
+    // activation (forward-mode differentiation), writing the output Jacobian
+    // as jacobian[output][input]. 'scratch' holds 2 * widest hidden layer *
+    // (inputDim + 1) floats.
+    void forwardJacobian(const DenseLayer* layers, int numLayers, const float* input, float* output,
+                         float* jacobian, float* scratch, ActivationPrecision precision);
+}
\ No newline at end of file
@@ -0,0 +1,532 @@
+/* TD-NeuroMap JSON Stream Implementation */
+
+#include "JsonStream.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+    // 10^0 .. 10^22 are exact in double
+    const int MaxExactPower = 22;
+
+    // Covers every decimal exponent a float is formatted with
+    const int TablePowers = 64;
+
+    // Mantissas are accumulated up to 18 digits; later digits only shift the exponent
+    const uint64_t MantissaLimit = 100000000000000000ull;
+
+    struct PowerTable
+    {
+        double values[2 * TablePowers + 1];
+
+        PowerTable()
+        {
+            double exact = 1.0;
+            for (int e = 0; e <= TablePowers; ++e)
+            {
+                values[TablePowers + e] = e <= MaxExactPower ? exact : std::pow(10.0, e);
+                values[TablePowers - e] = e <= MaxExactPower ? 1.0 / exact : std::pow(10.0, -e);
+                exact *= 10.0;
+            }
+        }
+    };
+
+    const PowerTable Powers;
+
+    double powerOfTen(int exponent)
+    {
+        if (exponent >= -TablePowers && exponent <= TablePowers)
+            return Powers.values[TablePowers + exponent];
+        return std::pow(10.0, exponent);
+    }
+
+    float fromBits(uint32_t bits)
+    {
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    bool isDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    char* writeDigits(char* out, uint32_t digits, int count)
+    {
+        for (int i = count - 1; i >= 0; --i)
+        {
+            out[i] = static_cast<char>('0' + digits % 10);
+            digits /= 10;
+        }
+        return out + count;
+    }
+}
+
+JsonReader::JsonReader(const char* data, size_t size)
+    : m_data(data)
+    , m_size(size)
+    , m_pos(0)
+    , m_failed(false)
+{
+}
+
+bool JsonReader::beginObject()
+{
+    return expect('{');
+}
+
+bool JsonReader::nextKey(std::string& key)
+{
+    if (m_failed)
+        return false;
+
+    skipWhitespace();
+    if (m_pos < m_size && m_data[m_pos] == ',')
+    {
+        ++m_pos;
+        skipWhitespace();
+    }
+    if (m_pos < m_size && m_data[m_pos] == '}')
+    {
+        ++m_pos;
+        return false;
+    }
+    return readString(&key) && expect(':');
+}
+
+bool JsonReader::beginArray()
+{
+    return expect('[');
+}
+
+bool JsonReader::nextElement()
+{
+    if (m_failed)
+        return false;
+
+    skipWhitespace();
+    if (m_pos < m_size && m_data[m_pos] == ',')
+    {
+        ++m_pos;
+        skipWhitespace();
+    }
+    if (m_pos < m_size && m_data[m_pos] == ']')
+    {
+        ++m_pos;
+        return false;
+    }
+    return m_pos < m_size || fail();
+}
+
+bool JsonReader::readDouble(double& value)
+{
+    if (m_failed)
+        return false;
+
+    // Decimal mantissa and exponent, then one multiply or divide: correctly
+    // rounded for up to 15 digits and exponents within +-22, which covers
+    // every float written by JsonWriter; otherwise within a few double ulps,
+    // far below float precision.
+    skipWhitespace();
+    bool negative = false;
+    if (m_pos < m_size && m_data[m_pos] == '-')
+    {
+        negative = true;
+        ++m_pos;
+    }
+
+    uint64_t mantissa = 0;
+    int exponent = 0;
+    bool anyDigit = false;
+    while (m_pos < m_size && isDigit(m_data[m_pos]))
+    {
+        if (mantissa < MantissaLimit)
+            mantissa = mantissa * 10 + static_cast<uint64_t>(m_data[m_pos] - '0');
+        else
+            ++exponent;
+        anyDigit = true;
+        ++m_pos;
+    }
+    if (m_pos < m_size && m_data[m_pos] == '.')
+    {
+        ++m_pos;
+        while (m_pos < m_size && isDigit(m_data[m_pos]))
+        {
+            if (mantissa < MantissaLimit)
+            {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(m_data[m_pos] - '0');
+                --exponent;
+            }
+            anyDigit = true;
+            ++m_pos;
+        }
+    }
+    if (!anyDigit)
+    {
+        return fail();
+    }
+
+    if (m_pos < m_size && (m_data[m_pos] == 'e' || m_data[m_pos] == 'E'))
+    {
+        ++m_pos;
+        bool negativeExponent = false;
+        if (m_pos < m_size && (m_data[m_pos] == '-' || m_data[m_pos] == '+'))
+        {
+            negativeExponent = m_data[m_pos] == '-';
+            ++m_pos;
+        }
+        if (m_pos >= m_size || !isDigit(m_data[m_pos]))
+        {
+            return fail();
+        }
+        int written = 0;
+        while (m_pos < m_size && isDigit(m_data[m_pos]))
+        {
+            if (written < 10000)
+                written = written * 10 + (m_data[m_pos] - '0');
+            ++m_pos;
+        }
+        exponent += negativeExponent ? -written : written;
+    }
+
+    double result = static_cast<double>(mantissa);
+    if (mantissa != 0)
+    {
+        if (exponent < 0 && exponent >= -MaxExactPower)
+            result /= powerOfTen(-exponent);
+        else if (exponent < -300)
+            result = result * powerOfTen(-300) * powerOfTen(exponent + 300);
+        else
+            result *= powerOfTen(exponent);
+    }
+    value = negative ? -result : result;
+    return true;
+}
+
+bool JsonReader::readFloat(float& value)
+{
+    double v = 0.0;
+    if (!readDouble(v))
+        return false;
+    value = static_cast<float>(v);
+    return true;
+}
+
+bool JsonReader::readInt(int& value)
+{
+    double v = 0.0;
+    if (!readDouble(v))
+        return false;
+    if (v != std::floor(v) || std::abs(v) > static_cast<double>(std::numeric_limits<int>::max()))
+        return fail();
+    value = static_cast<int>(v);
+    return true;
+}
+
+bool JsonReader::skipValue()
+{
+    if (m_failed)
+        return false;
+
+    skipWhitespace();
+    if (m_pos >= m_size)
+        return fail();
+
+    const char c = m_data[m_pos];
+    if (c == '"')
+        return readString(nullptr);
+    if (c == '-' || isDigit(c))
+    {
+        double ignored;
+        return readDouble(ignored);
+    }
+    if (c != '{' && c != '[')
+    {
+        // true, false, null
+        while (m_pos < m_size && m_data[m_pos] >= 'a' && m_data[m_pos] <= 'z')
+            ++m_pos;
+        return true;
+    }
+
+    // Containers are skipped by bracket depth; strings may hold brackets
+    int depth = 0;
+    while (m_pos < m_size)
+    {
+        const char ch = m_data[m_pos];
+        if (ch == '"')
+        {
+            if (!readString(nullptr))
+                return false;
+            continue;
+        }
+        ++m_pos;
+        if (ch == '{' || ch == '[')
+            ++depth;
+        else if ((ch == '}' || ch == ']') && --depth == 0)
+            return true;
+    }
+    return fail();
+}
+
+bool JsonReader::atEnd()
+{
+    skipWhitespace();
+    return !m_failed && m_pos == m_size;
+}
+
+void JsonReader::skipWhitespace()
+{
+    while (m_pos < m_size)
+    {
+        const char c = m_data[m_pos];
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t')
+            break;
+        ++m_pos;
+    }
+}
+
+bool JsonReader::expect(char c)
+{
+    if (m_failed)
+        return false;
+
+    skipWhitespace();
+    if (m_pos >= m_size || m_data[m_pos] != c)
+        return fail();
+    ++m_pos;
+    return true;
+}
+
+bool JsonReader::readString(std::string* value)
+{
+    if (!expect('"'))
+        return false;
+
+    if (value)
+        value->clear();
+    while (m_pos < m_size)
+    {
+        const char c = m_data[m_pos++];
+        if (c == '"')
+            return true;
+        if (c == '\\')
+        {
+            if (m_pos >= m_size)
+                break;
+            // Escapes are kept as their character; keys in the formats we
+            // read are plain ASCII
+            const char escaped = m_data[m_pos++];
+            if (value)
+                value->push_back(escaped == 'n' ? '\n' : escaped == 't' ? '\t' : escaped);
+            continue;
+        }
+        if (value)
+            value->push_back(c);
+    }
+    return fail();
+}
+
+bool JsonReader::fail()
+{
+    m_failed = true;
+    return false;
+}
+
+JsonWriter::JsonWriter(std::vector<char>& out)
+    : m_out(out)
+    , m_afterKey(false)
+{
+}
+
+void JsonWriter::beginObject()
+{
+    separate();
+    m_out.push_back('{');
+    m_first.push_back(true);
+}
+
+void JsonWriter::endObject()
+{
+    m_out.push_back('}');
+    m_first.pop_back();
+}
+
+void JsonWriter::beginArray()
+{
+    separate();
+    m_out.push_back('[');
+    m_first.push_back(true);
+}
+
+void JsonWriter::endArray()
+{
+    m_out.push_back(']');
+    m_first.pop_back();
+}
+
+void JsonWriter::key(const char* name)
+{
+    separate();
+    m_out.push_back('"');
+    append(name, std::strlen(name));
+    m_out.push_back('"');
+    m_out.push_back(':');
+    m_afterKey = true;
+}
+
+void JsonWriter::value(float v)
+{
+    separate();
+    const size_t pos = m_out.size();
+    m_out.resize(pos + 16);
+    m_out.resize(pos + static_cast<size_t>(formatFloat(v, m_out.data() + pos)));
+}
+
+void JsonWriter::value(int v)
+{
+    separate();
+    char buffer[16];
+    char* end = buffer + sizeof(buffer);
+    char* p = end;
+    uint32_t magnitude = v < 0 ? 0u - static_cast<uint32_t>(v) : static_cast<uint32_t>(v);
+    do
+    {
+        *--p = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (v < 0)
+        *--p = '-';
+    append(p, static_cast<size_t>(end - p));
+}
+
+int JsonWriter::formatFloat(float v, char* buffer)
+{
+    char* out = buffer;
+    if (!std::isfinite(v) || v == 0.0f)
+    {
+        *out = '0';
+        return 1;
+    }
+    if (v < 0.0f)
+    {
+        *out++ = '-';
+        v = -v;
+    }
+
+    // Decimal exponent from the binary one (78913 / 2^18 ~ log10(2)),
+    // corrected by comparisons; off by one at most for normal floats
+    const double a = v;
+    uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    const int binaryExponent = std::max(static_cast<int>(bits >> 23), 1) - 127;
+    int exponent = (binaryExponent * 78913) >> 18;
+    while (a >= powerOfTen(exponent + 1))
+        ++exponent;
+    while (a < powerOfTen(exponent))
+        --exponent;
+
+    // Nine significant digits always read back as the same float. Fewer
+    // are used when that decimal lies well inside the float's rounding
+    // interval, so every correctly rounding reader returns the same float.
+    uint32_t digits = static_cast<uint32_t>(a * powerOfTen(8 - exponent) + 0.5);
+    if (digits >= 1000000000u)
+    {
+        digits /= 10;
+        ++exponent;
+    }
+    int count = 9;
+    const double tolerance = 0.45 * std::min(static_cast<double>(fromBits(bits + 1)) - a,
+                                             a - static_cast<double>(fromBits(bits - 1)));
+    uint32_t divisor = 1000;
+    for (int shorter = 6; shorter < 9; ++shorter, divisor /= 10)
+    {
+        const uint32_t candidate = (digits + divisor / 2) / divisor;
+        const double back = candidate * powerOfTen(exponent - shorter + 1);
+        if (std::abs(back - a) < tolerance)
+        {
+            digits = candidate;
+            count = shorter;
+            break;
+        }
+    }
+    // Rounding up may carry into a new digit (999999.5 -> 1000000)
+    if (digits >= static_cast<uint32_t>(powerOfTen(count)))
+    {
+        digits /= 10;
+        ++exponent;
+    }
+    while (count > 1 && digits % 10 == 0)
+    {
+        digits /= 10;
+        --count;
+    }
+
+    char text[9];
+    writeDigits(text, digits, count);
+    if (exponent >= 0 && exponent < 9)
+    {
+        // ddd, ddd.ddd
+        const int integerDigits = exponent + 1;
+        for (int i = 0; i < integerDigits; ++i)
+            *out++ = i < count ? text[i] : '0';
+        if (count > integerDigits)
+        {
+            *out++ = '.';
+            for (int i = integerDigits; i < count; ++i)
+                *out++ = text[i];
+        }
+    }
+    else if (exponent < 0 && exponent >= -5)
+    {
+        // 0.000ddd
+        *out++ = '0';
+        *out++ = '.';
+        for (int i = -1; i > exponent; --i)
+            *out++ = '0';
+        for (int i = 0; i < count; ++i)
+            *out++ = text[i];
+    }
+    else
+    {
+        // d.ddde-XX
+        *out++ = text[0];
+        if (count > 1)
+        {
+            *out++ = '.';
+            for (int i = 1; i < count; ++i)
+                *out++ = text[i];
+        }
+        *out++ = 'e';
+        if (exponent < 0)
+        {
+            *out++ = '-';
+            exponent = -exponent;
+        }
+        out = writeDigits(out, static_cast<uint32_t>(exponent), exponent >= 10 ? 2 : 1);
+    }
+    return static_cast<int>(out - buffer);
+}
+
+void JsonWriter::separate()
+{
+    if (m_afterKey)
+    {
+        m_afterKey = false;
+        return;
+    }
+    if (!m_first.empty())
+    {
+        if (!m_first.back())
+            m_out.push_back(',');
+        m_first.back() = false;
+    }
+}
+
+void JsonWriter::append(const char* text, size_t size)
+{
+    m_out.insert(m_out.end(), text, text + size);
+}
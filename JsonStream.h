@@ -0,0 +1,76 @@
+/* TD-NeuroMap JSON Stream
+ * Pull reader and append-only writer for JSON, for formats exchanged with
+ * other tools. Neither builds a document tree: callers walk the structure
+ * and move numbers straight to and from their own storage.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class JsonReader
+{
+public:
+    JsonReader(const char* data, size_t size);
+
+    // Objects: beginObject(), then nextKey() until it returns false, which
+    // consumes the closing brace. Arrays work the same with nextElement().
+    // Every call after a failure returns false.
+    bool beginObject();
+    bool nextKey(std::string& key);
+    bool beginArray();
+    bool nextElement();
+
+    bool readDouble(double& value);
+    bool readFloat(float& value);
+    bool readInt(int& value);
+    bool skipValue();
+
+    // Whether only whitespace is left, i.e. the document ended cleanly
+    bool atEnd();
+
+    bool failed() const { return m_failed; }
+    size_t getPosition() const { return m_pos; }
+
+private:
+    const char* m_data;
+    size_t m_size;
+    size_t m_pos;
+    bool m_failed;
+
+    void skipWhitespace();
+    bool expect(char c);
+    bool readString(std::string* value);
+    bool fail();
+};
+
+class JsonWriter
+{
+public:
+    // Appends compact JSON to 'out'
+    explicit JsonWriter(std::vector<char>& out);
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+    void key(const char* name);
+    void value(float v);
+    void value(int v);
+
+    // Decimal that reads back as the same float: the fewest of 6 to 9
+    // significant digits that round-trips, trailing zeros dropped. Writes
+    // at most 16 chars to 'buffer' and returns the count. Non-finite values
+    // become 0.
+    static int formatFloat(float v, char* buffer);
+
+private:
+    std::vector<char>& m_out;
+    std::vector<bool> m_first;      // Per open container: no element written yet
+    bool m_afterKey;                // The next value belongs to the key just written
+
+    void separate();
+    void append(const char* text, size_t size);
+};
@@ -0,0 +1,164 @@
+/* TD-NeuroMap Mapped File Implementation */
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+#ifdef _WIN32
+    struct FileHandle
+    {
+        HANDLE file = INVALID_HANDLE_VALUE;
+        HANDLE mapping = nullptr;
+        uint64_t size = 0;
+
+        ~FileHandle()
+        {
+            if (mapping)
+                CloseHandle(mapping);
+            if (file != INVALID_HANDLE_VALUE)
+                CloseHandle(file);
+        }
+    };
+#else
+    struct FileHandle
+    {
+        int fd = -1;
+        uint64_t size = 0;
+
+        ~FileHandle()
+        {
+            if (fd >= 0)
+                close(fd);
+        }
+    };
+#endif
+}
+
+MappedFile::MappedFile()
+    : m_data(nullptr)
+    , m_size(0)
+    , m_offset(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    if (!m_data)
+    {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+#else
+    munmap(m_data, m_size);
+#endif
+}
+
+std::shared_ptr<MappedFile> MappedFile::open(const std::string& path, std::string& error)
+{
+    std::shared_ptr<FileHandle> handle = std::make_shared<FileHandle>();
+    std::shared_ptr<MappedFile> file(new MappedFile());
+    file->m_path = path;
+
+#ifdef _WIN32
+    handle->file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    LARGE_INTEGER size;
+    if (handle->file == INVALID_HANDLE_VALUE || !GetFileSizeEx(handle->file, &size))
+    {
+        error = "Cannot open " + path;
+        return nullptr;
+    }
+    handle->size = static_cast<uint64_t>(size.QuadPart);
+    file->m_size = static_cast<size_t>(handle->size);
+    if (file->m_size > 0)
+    {
+        handle->mapping = CreateFileMappingA(handle->file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+        if (!handle->mapping)
+        {
+            error = "Cannot map " + path;
+            return nullptr;
+        }
+    }
+#else
+    handle->fd = ::open(path.c_str(), O_RDONLY);
+    struct stat info;
+    if (handle->fd < 0 || fstat(handle->fd, &info) != 0)
+    {
+        error = "Cannot open " + path;
+        return nullptr;
+    }
+    handle->size = static_cast<uint64_t>(info.st_size);
+    file->m_size = static_cast<size_t>(handle->size);
+#endif
+
+    file->m_handle = handle;
+    if (!file->map(error))
+    {
+        return nullptr;
+    }
+    return file;
+}
+
+std::shared_ptr<MappedFile> MappedFile::view(uint64_t offset, size_t size, std::string& error) const
+{
+    const FileHandle* handle = static_cast<const FileHandle*>(m_handle.get());
+    if (offset % ViewAlignment != 0 || offset > handle->size || size > handle->size - offset)
+    {
+        error = "Invalid view of " + m_path;
+        return nullptr;
+    }
+
+    std::shared_ptr<MappedFile> file(new MappedFile());
+    file->m_path = m_path;
+    file->m_size = size;
+    file->m_offset = offset;
+    file->m_handle = m_handle;
+    if (!file->map(error))
+    {
+        return nullptr;
+    }
+    return file;
+}
+
+bool MappedFile::map(std::string& error)
+{
+    // An empty file has nothing to map and is rejected by the parser
+    if (m_size == 0)
+    {
+        return true;
+    }
+
+    const FileHandle* handle = static_cast<const FileHandle*>(m_handle.get());
+#ifdef _WIN32
+    void* view = MapViewOfFile(handle->mapping, FILE_MAP_COPY, static_cast<DWORD>(m_offset >> 32),
+                               static_cast<DWORD>(m_offset), m_size);
+    if (!view)
+    {
+        error = "Cannot map " + m_path;
+        return false;
+    }
+#else
+    void* view = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, handle->fd,
+                      static_cast<off_t>(m_offset));
+    if (view == MAP_FAILED)
+    {
+        error = "Cannot map " + m_path;
+        return false;
+    }
+#endif
+    m_data = static_cast<char*>(view);
+    return true;
+}
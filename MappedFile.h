@@ -0,0 +1,47 @@
+/* TD-NeuroMap Mapped File
+ * Read-only file opened as a private copy-on-write memory mapping. Pages
+ * come straight from the OS file cache; writing to one gives this mapping
+ * its own copy of that page and never touches the file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+class MappedFile
+{
+public:
+    // Offsets of partial views must be multiples of this: the Windows
+    // allocation granularity, which every supported page size divides
+    static const size_t ViewAlignment = 65536;
+
+    // Returns nullptr and sets 'error' if the file cannot be mapped
+    static std::shared_ptr<MappedFile> open(const std::string& path, std::string& error);
+
+    ~MappedFile();
+
+    // A copy-on-write view of bytes [offset, offset + size) of the same
+    // file, for containers whose parts are used on their own
+    std::shared_ptr<MappedFile> view(uint64_t offset, size_t size, std::string& error) const;
+
+    char* data() { return m_data; }
+    const char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    const std::string& getPath() const { return m_path; }
+
+private:
+    MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool map(std::string& error);
+
+    std::string m_path;
+    char* m_data;
+    size_t m_size;
+    uint64_t m_offset;                  // Of the view within the file
+    std::shared_ptr<void> m_handle;     // Open file, shared by partial views
+};
@@ -0,0 +1,215 @@
+/* TD-NeuroMap Model Bank Implementation
+ *
+ * Bank file layout (native little-endian):
+ *   char[4]  magic "NMBK"
+ *   uint32   version
+ *   uint32   slotCount
+ *   per slot:
+ *     uint64 size                 (0 for an empty slot)
+ *     char   model[size]          (ModelFile format)
+ */
+
+#include "ModelBank.h"
+#include "ModelFile.h"
+#include "NormalizationFold.h"
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+    const char Magic[4] = { 'N', 'M', 'B', 'K' };
+    const uint32_t Version = 1;
+
+    template <typename T>
+    void writeValue(std::vector<char>& out, const T& value)
+    {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    template <typename T>
+    bool readValue(const std::vector<char>& bytes, size_t& pos, T& value)
+    {
+        if (sizeof(T) > bytes.size() - pos)
+            return false;
+        std::memcpy(&value, bytes.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return true;
+    }
+}
+
+bool ModelBank::store(int slot, BankSlot model, std::string& error)
+{
+    if (slot < 0 || slot >= MaxSlots)
+    {
+        error = "Bank slot must be between 0 and " + std::to_string(MaxSlots - 1);
+        return false;
+    }
+    if (!model.network)
+    {
+        error = "No model to store";
+        return false;
+    }
+    if (!matchesDimensions(model.network->getArchitecture()))
+    {
+        error = "Model dimensions differ from the models already in the bank";
+        return false;
+    }
+
+    if (!model.folded)
+    {
+        model.folded = NormalizationFold::makeFolded(*model.network, model.normalization);
+    }
+    if (slot >= getNumSlots())
+    {
+        m_slots.resize(slot + 1);
+    }
+    m_slots[slot] = std::move(model);
+    return true;
+}
+
+void ModelBank::clear()
+{
+    m_slots.clear();
+}
+
+void ModelBank::setDerived(int slot, std::shared_ptr<const QuantizedNetwork> quantized,
+                           std::shared_ptr<const BakedLUT> lut, std::shared_ptr<const SparseNetwork> sparse)
+{
+    if (slot < 0 || slot >= getNumSlots() || !m_slots[slot].network)
+    {
+        return;
+    }
+    m_slots[slot].quantized = std::move(quantized);
+    m_slots[slot].lut = std::move(lut);
+    m_slots[slot].sparse = std::move(sparse);
+}
+
+int ModelBank::getNumModels() const
+{
+    int count = 0;
+    for (const auto& slot : m_slots)
+    {
+        if (slot.network)
+            ++count;
+    }
+    return count;
+}
+
+const BankSlot* ModelBank::getSlot(int slot) const
+{
+    if (slot < 0 || slot >= getNumSlots() || !m_slots[slot].network)
+    {
+        return nullptr;
+    }
+    return &m_slots[slot];
+}
+
+bool ModelBank::save(const std::string& path, std::string& error) const
+{
+    std::vector<char> bytes;
+    bytes.insert(bytes.end(), Magic, Magic + sizeof(Magic));
+    writeValue(bytes, Version);
+    writeValue(bytes, static_cast<uint32_t>(m_slots.size()));
+
+    std::vector<char> model;
+    for (const auto& slot : m_slots)
+    {
+        if (!slot.network)
+        {
+            writeValue(bytes, static_cast<uint64_t>(0));
+            continue;
+        }
+
+        ModelFile::serialize(*slot.network, slot.normalization, model);
+        writeValue(bytes, static_cast<uint64_t>(model.size()));
+        bytes.insert(bytes.end(), model.begin(), model.end());
+    }
+
+    return ModelFile::writeBytes(path, bytes, error);
+}
+
+bool ModelBank::load(const std::string& path, std::string& error)
+{
+    std::vector<char> bytes;
+    if (!ModelFile::readBytes(path, bytes, error))
+    {
+        return false;
+    }
+
+    size_t pos = 0;
+    char magic[4];
+    uint32_t version = 0;
+    uint32_t slotCount = 0;
+    if (bytes.size() < sizeof(magic) || std::memcmp(bytes.data(), Magic, sizeof(Magic)) != 0)
+    {
+        error = "Not a NeuroMap bank file";
+        return false;
+    }
+    pos += sizeof(magic);
+    if (!readValue(bytes, pos, version) || version != Version)
+    {
+        error = "Unsupported bank file version " + std::to_string(version);
+        return false;
+    }
+    if (!readValue(bytes, pos, slotCount) || slotCount > static_cast<uint32_t>(MaxSlots))
+    {
+        error = "Invalid bank slot count";
+        return false;
+    }
+
+    ModelBank loaded;
+    std::vector<char> model;
+    for (uint32_t i = 0; i < slotCount; ++i)
+    {
+        uint64_t size = 0;
+        if (!readValue(bytes, pos, size) || size > bytes.size() - pos)
+        {
+            error = "Truncated bank slot " + std::to_string(i);
+            return false;
+        }
+        if (size == 0)
+        {
+            loaded.m_slots.emplace_back();
+            continue;
+        }
+
+        model.assign(bytes.begin() + pos, bytes.begin() + pos + static_cast<size_t>(size));
+        pos += static_cast<size_t>(size);
+
+        BankSlot slot;
+        std::string modelError;
+        std::unique_ptr<NeuralNetwork> folded;
+        std::unique_ptr<NeuralNetwork> network = ModelFile::parse(model, slot.normalization, folded, modelError);
+        if (!network)
+        {
+            error = "Bank slot " + std::to_string(i) + ": " + modelError;
+            return false;
+        }
+        if (!loaded.matchesDimensions(network->getArchitecture()))
+        {
+            error = "Bank slot " + std::to_string(i) + " has different dimensions";
+            return false;
+        }
+
+        slot.network = std::move(network);
+        slot.folded = std::move(folded);
+        loaded.m_slots.push_back(std::move(slot));
+    }
+
+    m_slots = std::move(loaded.m_slots);
+    return true;
+}
+
+bool ModelBank::matchesDimensions(const NetworkArchitecture& arch) const
+{
+    for (const auto& slot : m_slots)
+    {
+        if (slot.network)
+        {
+            const NetworkArchitecture& existing = slot.network->getArchitecture();
+            return existing.inputDim == arch.inputDim && existing.outputDim == arch.outputDim;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,61 @@
+/* TD-NeuroMap Model Bank
+ * Several trained models held resident in one node and selected by index.
+ * All models in a bank share input and output dimensions, so switching
+ * slots never changes the node's channel layout.
+ */
+
+#pragma once
+
+#include "NeuralNetwork.h"
+#include "DataManager.h"
+#include "QuantizedNetwork.h"
+#include "BakedLUT.h"
+#include "SparseNetwork.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+struct BankSlot
+{
+    std::shared_ptr<const NeuralNetwork> network;   // Null for an empty slot
+    std::shared_ptr<const NeuralNetwork> folded;    // Raw-space form, null without normalization
+    NormalizationBounds normalization;
+
+    // Run-mode forms built from this model, swapped in with it so that a
+    // slot switch never rebuilds them; null when not built
+    std::shared_ptr<const QuantizedNetwork> quantized;
+    std::shared_ptr<const BakedLUT> lut;
+    std::shared_ptr<const SparseNetwork> sparse;    // Built from 'folded' when there is one
+};
+
+class ModelBank
+{
+public:
+    static constexpr int MaxSlots = 64;
+
+    // Puts 'model' in 'slot', growing the bank with empty slots as needed.
+    // A model without a folded form gets one from its normalization.
+    bool store(int slot, BankSlot model, std::string& error);
+    void clear();
+
+    // Replaces the derived forms of the model in 'slot'; ignored for an
+    // empty slot
+    void setDerived(int slot, std::shared_ptr<const QuantizedNetwork> quantized,
+                    std::shared_ptr<const BakedLUT> lut, std::shared_ptr<const SparseNetwork> sparse);
+
+    int getNumSlots() const { return static_cast<int>(m_slots.size()); }
+    int getNumModels() const;
+
+    // Returns nullptr for an empty or out-of-range slot
+    const BankSlot* getSlot(int slot) const;
+
+    // The whole bank as a single file, without the derived forms; load()
+    // leaves the bank unchanged on failure
+    bool save(const std::string& path, std::string& error) const;
+    bool load(const std::string& path, std::string& error);
+
+private:
+    std::vector<BankSlot> m_slots;
+
+    bool matchesDimensions(const NetworkArchitecture& arch) const;
+};
@@ -0,0 +1,474 @@
+/* TD-NeuroMap Model File Implementation
+ *
+ * Version 3 layout (native little-endian):
+ *   0   char[4]  magic "NMAP"
+ *   4   uint32   version
+ *   8   uint64   checksum of bytes [16, end of file)
+ *   16  int32    inputDim, outputDim, hiddenUnits, hiddenLayers
+ *   32  uint32   hasNormalization
+ *   36  uint32   reserved, 0
+ *   40  uint64   storageSize
+ *   48  uint64   weightsOffset                            (multiple of 64)
+ *   56  float    inputMin[inputDim], inputMax[inputDim],
+ *                outputMin[outputDim], outputMax[outputDim] (if hasNormalization)
+ *       zero padding up to weightsOffset
+ *   weightsOffset:
+ *       float    storage[storageSize]                     (NeuralNetwork layout)
+ *
+ * The storage keeps NeuralNetwork's 64-byte aligned blocks, so loading is
+ * one copy straight out of the file's pages. Versions 1 and 2 have no checksum or offset; the
+ * storage size follows the bounds and the weights follow it unaligned.
+ *
+ * Since version 2 the weights of a model with normalization are stored with
+ * the bounds folded in (raw inputs to raw outputs), which is the form Run
+ * mode executes. Version 1 files hold network-space weights.
+ */
+
+#include "ModelFile.h"
+#include "FluCoMaModel.h"
+#include "NormalizationFold.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+namespace
+{
+    const char Magic[4] = { 'N', 'M', 'A', 'P' };
+    const uint32_t Version = 3;
+    const uint32_t FirstFoldedVersion = 2;
+    const uint32_t FirstMappableVersion = 3;
+    const size_t ChecksumOffset = 8;
+    const size_t ChecksummedOffset = 16;
+    const size_t WeightsAlignment = AlignedBuffer::Alignment;
+
+    void writeRaw(std::vector<char>& out, const void* data, size_t size)
+    {
+        const char* bytes = static_cast<const char*>(data);
+        out.insert(out.end(), bytes, bytes + size);
+    }
+
+    template <typename T>
+    void writeValue(std::vector<char>& out, const T& value)
+    {
+        writeRaw(out, &value, sizeof(T));
+    }
+
+    void writeFloats(std::vector<char>& out, const float* values, size_t count)
+    {
+        writeRaw(out, values, count * sizeof(float));
+    }
+
+    class Reader
+    {
+    public:
+        Reader(const char* data, size_t size)
+            : m_data(data)
+            , m_size(size)
+            , m_pos(0)
+        {
+        }
+
+        template <typename T>
+        bool read(T& value)
+        {
+            return readRaw(&value, sizeof(T));
+        }
+
+        bool readFloats(std::vector<float>& values, size_t count)
+        {
+            values.resize(count);
+            return readRaw(values.data(), count * sizeof(float));
+        }
+
+        bool readRaw(void* dst, size_t size)
+        {
+            if (size > m_size - m_pos)
+                return false;
+            std::memcpy(dst, m_data + m_pos, size);
+            m_pos += size;
+            return true;
+        }
+
+        size_t getPosition() const { return m_pos; }
+
+    private:
+        const char* m_data;
+        size_t m_size;
+        size_t m_pos;
+    };
+
+    struct Header
+    {
+        uint32_t version = 0;
+        NetworkArchitecture arch;
+        bool hasNormalization = false;
+        size_t weightsOffset = 0;
+    };
+
+    // Validates everything up to the weights, including the checksum of
+    // version 3 files, and locates the weight storage
+    bool readHeader(const char* data, size_t size, Header& header, NormalizationBounds& normalization,
+                    std::string& error)
+    {
+        Reader reader(data, size);
+
+        char magic[4];
+        if (!reader.readRaw(magic, sizeof(magic)) || std::memcmp(magic, Magic, sizeof(Magic)) != 0 ||
+            !reader.read(header.version))
+        {
+            error = "Not a NeuroMap model file";
+            return false;
+        }
+        if (header.version < 1 || header.version > Version)
+        {
+            error = "Unsupported model file version " + std::to_string(header.version);
+            return false;
+        }
+
+        if (header.version >= FirstMappableVersion)
+        {
+            uint64_t checksum = 0;
+            if (!reader.read(checksum))
+            {
+                error = "Truncated model header";
+                return false;
+            }
+            if (checksum != ModelFile::checksum(data + ChecksummedOffset, size - ChecksummedOffset))
+            {
+                error = "Model file is corrupt (checksum mismatch)";
+                return false;
+            }
+        }
+
+        int32_t dims[4];
+        uint32_t hasNormalization = 0;
+        uint32_t reserved = 0;
+        uint64_t storageSize = 0;
+        uint64_t weightsOffset = 0;
+        if (!reader.readRaw(dims, sizeof(dims)) || !reader.read(hasNormalization) ||
+            (header.version >= FirstMappableVersion &&
+             !(reader.read(reserved) && reader.read(storageSize) && reader.read(weightsOffset))))
+        {
+            error = "Truncated model header";
+            return false;
+        }
+
+        NetworkArchitecture& arch = header.arch;
+        arch.inputDim = dims[0];
+        arch.outputDim = dims[1];
+        arch.hiddenUnits = dims[2];
+        arch.hiddenLayers = dims[3];
+        if (!ModelFile::isValidArchitecture(arch))
+        {
+            error = "Invalid model architecture";
+            return false;
+        }
+
+        normalization = NormalizationBounds();
+        header.hasNormalization = hasNormalization != 0;
+        if (header.hasNormalization &&
+            !(reader.readFloats(normalization.inputMin, arch.inputDim) &&
+              reader.readFloats(normalization.inputMax, arch.inputDim) &&
+              reader.readFloats(normalization.outputMin, arch.outputDim) &&
+              reader.readFloats(normalization.outputMax, arch.outputDim)))
+        {
+            error = "Truncated normalization bounds";
+            return false;
+        }
+
+        if (header.version < FirstMappableVersion)
+        {
+            if (!reader.read(storageSize))
+            {
+                error = "Truncated weights";
+                return false;
+            }
+            weightsOffset = reader.getPosition();
+        }
+        else if (weightsOffset % WeightsAlignment != 0 || weightsOffset < reader.getPosition())
+        {
+            error = "Invalid weight offset";
+            return false;
+        }
+
+        if (storageSize != NeuralNetwork::getStorageSize(arch))
+        {
+            error = "Weight count does not match the architecture";
+            return false;
+        }
+        if (weightsOffset > size || storageSize > (size - weightsOffset) / sizeof(float))
+        {
+            error = "Truncated weights";
+            return false;
+        }
+
+        header.weightsOffset = static_cast<size_t>(weightsOffset);
+        return true;
+    }
+
+    // 'stored' holds the file's weights; returns the network-space model and
+    // sets 'folded' to the raw-space one when the model has normalization
+    std::unique_ptr<NeuralNetwork> deriveForms(const Header& header, const NormalizationBounds& normalization,
+                                               std::unique_ptr<NeuralNetwork> stored,
+                                               std::unique_ptr<NeuralNetwork>& folded)
+    {
+        folded.reset();
+        if (!header.hasNormalization)
+        {
+            return stored;
+        }
+
+        // Keep the stored runtime form as is and derive the other one
+        std::unique_ptr<NeuralNetwork> network;
+        if (header.version >= FirstFoldedVersion)
+        {
+            folded = std::move(stored);
+            network.reset(new NeuralNetwork(*folded));
+            NormalizationFold::unfold(*network, normalization);
+        }
+        else
+        {
+            network = std::move(stored);
+            folded.reset(new NeuralNetwork(*network));
+            NormalizationFold::fold(*folded, normalization);
+        }
+        return network;
+    }
+
+    std::unique_ptr<NeuralNetwork> copyWeights(const Header& header, const char* data)
+    {
+        std::unique_ptr<NeuralNetwork> network(new NeuralNetwork(header.arch));
+        std::memcpy(network->getStorage(), data + header.weightsOffset, network->getStorageSize() * sizeof(float));
+        network->updateKernelWeights();
+        return network;
+    }
+
+    std::unique_ptr<NeuralNetwork> parseData(const char* data, size_t size, NormalizationBounds& normalization,
+                                             std::unique_ptr<NeuralNetwork>& folded, std::string& error)
+    {
+        folded.reset();
+        if (FluCoMaModel::isJson(data, size))
+        {
+            normalization = NormalizationBounds();
+            return FluCoMaModel::parse(data, size, error);
+        }
+
+        Header header;
+        if (!readHeader(data, size, header, normalization, error))
+        {
+            return nullptr;
+        }
+        return deriveForms(header, normalization, copyWeights(header, data), folded);
+    }
+
+    bool replaceFile(const std::string& from, const std::string& to)
+    {
+#ifdef _WIN32
+        return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+        return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+    }
+}
+
+namespace ModelFile
+{
+
+bool save(const std::string& path, const NeuralNetwork& network,
+          const NormalizationBounds& normalization, std::string& error)
+{
+    std::vector<char> bytes;
+    if (FluCoMaModel::hasJsonExtension(path))
+        FluCoMaModel::serialize(network, normalization, bytes);
+    else
+        serialize(network, normalization, bytes);
+    return writeBytes(path, bytes, error);
+}
+
+void serialize(const NeuralNetwork& network, const NormalizationBounds& normalization,
+               std::vector<char>& out)
+{
+    const NetworkArchitecture& arch = network.getArchitecture();
+    out.clear();
+    out.reserve(2 * WeightsAlignment + network.getStorageSize() * sizeof(float));
+    writeRaw(out, Magic, sizeof(Magic));
+    writeValue(out, Version);
+    writeValue(out, static_cast<uint64_t>(0));      // Checksum, filled in last
+    writeValue(out, static_cast<int32_t>(arch.inputDim));
+    writeValue(out, static_cast<int32_t>(arch.outputDim));
+    writeValue(out, static_cast<int32_t>(arch.hiddenUnits));
+    writeValue(out, static_cast<int32_t>(arch.hiddenLayers));
+
+    bool hasNormalization = NormalizationFold::matches(arch, normalization);
+    size_t headerSize = out.size() + 2 * sizeof(uint32_t) + 2 * sizeof(uint64_t);
+    if (hasNormalization)
+    {
+        headerSize += 2 * (arch.inputDim + arch.outputDim) * sizeof(float);
+    }
+    const size_t weightsOffset = (headerSize + WeightsAlignment - 1) / WeightsAlignment * WeightsAlignment;
+
+    writeValue(out, static_cast<uint32_t>(hasNormalization ? 1 : 0));
+    writeValue(out, static_cast<uint32_t>(0));
+    writeValue(out, static_cast<uint64_t>(network.getStorageSize()));
+    writeValue(out, static_cast<uint64_t>(weightsOffset));
+    if (hasNormalization)
+    {
+        writeFloats(out, normalization.inputMin.data(), arch.inputDim);
+        writeFloats(out, normalization.inputMax.data(), arch.inputDim);
+        writeFloats(out, normalization.outputMin.data(), arch.outputDim);
+        writeFloats(out, normalization.outputMax.data(), arch.outputDim);
+    }
+    out.resize(weightsOffset, 0);
+
+    if (hasNormalization)
+    {
+        NeuralNetwork folded(network);
+        NormalizationFold::fold(folded, normalization);
+        writeFloats(out, folded.getStorage(), folded.getStorageSize());
+    }
+    else
+    {
+        writeFloats(out, network.getStorage(), network.getStorageSize());
+    }
+
+    uint64_t sum = checksum(out.data() + ChecksummedOffset, out.size() - ChecksummedOffset);
+    std::memcpy(out.data() + ChecksumOffset, &sum, sizeof(sum));
+}
+
+bool writeBytes(const std::string& path, const std::vector<char>& bytes, std::string& error)
+{
+    // Write a sibling file and rename it over the target. A load reading
+    // the old file keeps its contents, where truncating it in place would
+    // pull the pages out from under the reader.
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            error = "Cannot open " + tempPath + " for writing";
+            return false;
+        }
+
+        out.write(bytes.data(), bytes.size());
+        if (!out)
+        {
+            error = "Failed writing " + tempPath;
+            return false;
+        }
+    }
+
+    if (!replaceFile(tempPath, path))
+    {
+        std::remove(tempPath.c_str());
+        error = "Cannot replace " + path + " (is it in use?)";
+        return false;
+    }
+    return true;
+}
+
+bool readBytes(const std::string& path, std::vector<char>& bytes, std::string& error)
+{
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in)
+    {
+        error = "Cannot open " + path;
+        return false;
+    }
+
+    std::streamsize size = in.tellg();
+    in.seekg(0, std::ios::beg);
+    bytes.resize(static_cast<size_t>(size));
+    if (size > 0 && !in.read(bytes.data(), size))
+    {
+        error = "Failed reading " + path;
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<NeuralNetwork> parse(const std::vector<char>& bytes,
+                                     NormalizationBounds& normalization, std::string& error)
+{
+    std::unique_ptr<NeuralNetwork> folded;
+    return parse(bytes, normalization, folded, error);
+}
+
+std::unique_ptr<NeuralNetwork> parse(const std::vector<char>& bytes, NormalizationBounds& normalization,
+                                     std::unique_ptr<NeuralNetwork>& folded, std::string& error)
+{
+    return parseData(bytes.data(), bytes.size(), normalization, folded, error);
+}
+
+std::unique_ptr<NeuralNetwork> parse(const std::shared_ptr<MappedFile>& file, NormalizationBounds& normalization,
+                                     std::unique_ptr<NeuralNetwork>& folded, std::string& error)
+{
+    // The weights are copied out rather than run in place: a file rewritten
+    // from outside (cp, scp, rsync --inplace truncate the same inode) would
+    // otherwise fault or change under every model mapped from it
+    return parseData(file->data(), file->size(), normalization, folded, error);
+}
+
+bool isValidArchitecture(const NetworkArchitecture& arch)
+{
+    return arch.inputDim >= 1 && arch.outputDim >= 1 && arch.hiddenUnits >= 1 && arch.hiddenLayers >= 1 &&
+           arch.inputDim <= 4096 && arch.outputDim <= 4096 && arch.hiddenUnits <= 65536 && arch.hiddenLayers <= 64;
+}
+
+uint64_t hashBytes(const char* data, size_t size)
+{
+    uint64_t hash = 1469598103934665603ull;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64_t checksum(const char* data, size_t size)
+{
+    // Four independent FNV-1a lanes over 8-byte words hide the multiply
+    // latency; the tail and the lanes are folded in with the bytewise hash
+    const uint64_t Prime = 1099511628211ull;
+    uint64_t lanes[4] = { 1469598103934665603ull, 1469598103934665603ull ^ 1,
+                          1469598103934665603ull ^ 2, 1469598103934665603ull ^ 3 };
+    const size_t blockSize = 4 * sizeof(uint64_t);
+    size_t pos = 0;
+    for (; pos + blockSize <= size; pos += blockSize)
+    {
+        uint64_t words[4];
+        std::memcpy(words, data + pos, blockSize);
+        for (int i = 0; i < 4; ++i)
+        {
+            lanes[i] = (lanes[i] ^ words[i]) * Prime;
+        }
+    }
+
+    uint64_t hash = hashBytes(data + pos, size - pos);
+    for (int i = 0; i < 4; ++i)
+    {
+        hash = (hash ^ lanes[i]) * Prime;
+    }
+    return hash;
+}
+
+uint64_t contentHash(const char* data, size_t size)
+{
+    uint32_t version = 0;
+    uint64_t stored = 0;
+    if (size >= ChecksummedOffset && std::memcmp(data, Magic, sizeof(Magic)) == 0)
+    {
+        std::memcpy(&version, data + sizeof(Magic), sizeof(version));
+        std::memcpy(&stored, data + ChecksumOffset, sizeof(stored));
+    }
+    return version >= FirstMappableVersion ? stored : checksum(data, size);
+}
+
+} // namespace ModelFile
@@ -0,0 +1,60 @@
+/* TD-NeuroMap Model File
+ * Binary serialization of a trained network and its normalization bounds.
+ * Models with normalization are written with the bounds folded into the weights.
+ * Current files are checksummed and keep the weights 64-byte aligned, so a
+ * memory-mapped file loads with a single copy of the weights. Paths ending in .json
+ * save FluCoMa MLP JSON instead, and JSON data is recognized on load.
+ */
+
+#pragma once
+
+#include "NeuralNetwork.h"
+#include "DataManager.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ModelFile
+{
+    bool save(const std::string& path, const NeuralNetwork& network,
+              const NormalizationBounds& normalization, std::string& error);
+
+    // In-memory form of save(), for containers that embed models
+    void serialize(const NeuralNetwork& network, const NormalizationBounds& normalization,
+                   std::vector<char>& out);
+
+    // Replaces 'path' atomically, leaving models mapped from it intact
+    bool writeBytes(const std::string& path, const std::vector<char>& bytes, std::string& error);
+    bool readBytes(const std::string& path, std::vector<char>& bytes, std::string& error);
+
+    // Returns the network-space model, or nullptr and sets 'error' if the
+    // data is not a valid model
+    std::unique_ptr<NeuralNetwork> parse(const std::vector<char>& bytes,
+                                         NormalizationBounds& normalization, std::string& error);
+
+    // As above; 'folded' also receives the raw-space form with the
+    // normalization folded in, or null when the model has no normalization
+    std::unique_ptr<NeuralNetwork> parse(const std::vector<char>& bytes, NormalizationBounds& normalization,
+                                         std::unique_ptr<NeuralNetwork>& folded, std::string& error);
+
+    // As above, for a mapped file. The weights are copied out, so the
+    // returned networks never hold 'file' and outlive changes to it.
+    std::unique_ptr<NeuralNetwork> parse(const std::shared_ptr<MappedFile>& file, NormalizationBounds& normalization,
+                                         std::unique_ptr<NeuralNetwork>& folded, std::string& error);
+
+    // Architecture limits every model file is checked against
+    bool isValidArchitecture(const NetworkArchitecture& arch);
+
+    // 64-bit FNV-1a content hash
+    uint64_t hashBytes(const char* data, size_t size);
+
+    // Model file checksum: FNV-1a over 8-byte words in four interleaved
+    // lanes, fast enough to verify every load of a mapped model
+    uint64_t checksum(const char* data, size_t size);
+
+    // Identifies a model file's contents: the stored checksum of a current
+    // file, otherwise checksum() of the whole file
+    uint64_t contentHash(const char* data, size_t size);
+}
\ No newline at end of file
@@ -0,0 +1,167 @@
+/* TD-NeuroMap Model Morph Implementation */
+
+#include "ModelMorph.h"
+#include "SimdKernels.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Same degenerate-range threshold as NormalizationBounds::normalizeInput
+    const float MinRange = 1e-6f;
+
+    // Bounds of one dimension; identity when the model is not normalized
+    void getRange(const std::vector<float>& mins, const std::vector<float>& maxs, int dim,
+                  float& minVal, float& range)
+    {
+        if (dim < static_cast<int>(mins.size()) && dim < static_cast<int>(maxs.size()))
+        {
+            minVal = mins[dim];
+            range = maxs[dim] - mins[dim];
+        }
+        else
+        {
+            minVal = 0.0f;
+            range = 1.0f;
+        }
+    }
+
+    // Affine map from values normalized by (fromMin, fromRange) to values
+    // normalized by (toMin, toRange), through the shared raw space
+    void remap(float fromMin, float fromRange, float toMin, float toRange, float& scale, float& offset)
+    {
+        if (std::abs(toRange) < MinRange)
+        {
+            // DataManager maps every value of a degenerate range to 0.5
+            scale = 0.0f;
+            offset = 0.5f;
+            return;
+        }
+
+        float raw = std::abs(fromRange) < MinRange ? 0.0f : fromRange;
+        scale = raw / toRange;
+        offset = (fromMin - toMin) / toRange;
+    }
+}
+
+ModelMorph::ModelMorph()
+    : m_blendedAmount(-1.0f)
+{
+}
+
+void ModelMorph::setModels(std::shared_ptr<const NeuralNetwork> from, const NormalizationBounds& fromNorm,
+                           std::shared_ptr<const NeuralNetwork> to, const NormalizationBounds& toNorm)
+{
+    const NetworkArchitecture& arch = from->getArchitecture();
+    m_from = std::move(from);
+    m_toSource = std::move(to);
+    m_to.reset(new NeuralNetwork(*m_toSource));
+
+    // 'to' receives inputs normalized for 'from' and must produce outputs
+    // that 'from's bounds denormalize correctly
+    std::vector<float> scale(arch.inputDim), offset(arch.inputDim);
+    for (int k = 0; k < arch.inputDim; ++k)
+    {
+        float fromMin, fromRange, toMin, toRange;
+        getRange(fromNorm.inputMin, fromNorm.inputMax, k, fromMin, fromRange);
+        getRange(toNorm.inputMin, toNorm.inputMax, k, toMin, toRange);
+        remap(fromMin, fromRange, toMin, toRange, scale[k], offset[k]);
+    }
+    m_to->foldInputAffine(scale.data(), offset.data());
+
+    scale.resize(arch.outputDim);
+    offset.resize(arch.outputDim);
+    for (int j = 0; j < arch.outputDim; ++j)
+    {
+        float fromMin, fromRange, toMin, toRange;
+        getRange(toNorm.outputMin, toNorm.outputMax, j, toMin, toRange);
+        getRange(fromNorm.outputMin, fromNorm.outputMax, j, fromMin, fromRange);
+        remap(toMin, toRange, fromMin, fromRange, scale[j], offset[j]);
+    }
+    m_to->foldOutputAffine(scale.data(), offset.data());
+
+    if (m_to->getArchitecture() == arch)
+    {
+        m_blended.reset(new NeuralNetwork(*m_from));
+    }
+    else
+    {
+        m_blended.reset();
+    }
+    m_blendedAmount = -1.0f;
+
+    const int tile = SimdKernels::TileWidth;
+    m_tileOutputs.resize(static_cast<size_t>(2) * arch.outputDim * tile);
+    m_tileInputs.assign(arch.inputDim, nullptr);
+    m_tileFrom.resize(arch.outputDim);
+    m_tileTo.resize(arch.outputDim);
+    for (int j = 0; j < arch.outputDim; ++j)
+    {
+        m_tileFrom[j] = m_tileOutputs.data() + static_cast<size_t>(j) * tile;
+        m_tileTo[j] = m_tileOutputs.data() + static_cast<size_t>(arch.outputDim + j) * tile;
+    }
+}
+
+void ModelMorph::reset()
+{
+    m_from.reset();
+    m_toSource.reset();
+    m_to.reset();
+    m_blended.reset();
+    m_blendedAmount = -1.0f;
+}
+
+const NeuralNetwork& ModelMorph::blendWeights(float amount)
+{
+    if (amount != m_blendedAmount)
+    {
+        // Identical architectures share the storage layout, padding included
+        const float* a = m_from->getStorage();
+        const float* b = static_cast<const NeuralNetwork&>(*m_to).getStorage();
+        float* out = m_blended->getStorage();
+        const size_t size = m_blended->getStorageSize();
+        for (size_t i = 0; i < size; ++i)
+        {
+            out[i] = a[i] + amount * (b[i] - a[i]);
+        }
+        m_blended->updateKernelWeights();
+        m_blendedAmount = amount;
+    }
+    return *m_blended;
+}
+
+void ModelMorph::forwardBlendBatch(float amount, const float* const* inputs, float* const* outputs,
+                                   int count, float* scratch, ActivationPrecision precision)
+{
+    const int tile = SimdKernels::TileWidth;
+    const int inputDim = static_cast<int>(m_tileInputs.size());
+    const int outputDim = static_cast<int>(m_tileFrom.size());
+
+    for (int base = 0; base < count; base += tile)
+    {
+        int lanes = std::min(tile, count - base);
+        for (int k = 0; k < inputDim; ++k)
+        {
+            m_tileInputs[k] = inputs[k] + base;
+        }
+
+        m_from->forwardBatch(m_tileInputs.data(), m_tileFrom.data(), lanes, scratch, precision);
+        m_to->forwardBatch(m_tileInputs.data(), m_tileTo.data(), lanes, scratch, precision);
+
+        for (int j = 0; j < outputDim; ++j)
+        {
+            const float* a = m_tileFrom[j];
+            const float* b = m_tileTo[j];
+            float* out = outputs[j] + base;
+            for (int lane = 0; lane < lanes; ++lane)
+            {
+                out[lane] = a[lane] + amount * (b[lane] - a[lane]);
+            }
+        }
+    }
+}
+
+int ModelMorph::getBatchScratchSize() const
+{
+    return std::max(m_from->getBatchScratchSize(), m_to->getBatchScratchSize());
+}
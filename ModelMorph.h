@@ -0,0 +1,55 @@
+/* TD-NeuroMap Model Morph
+ * Continuous crossfade between two trained models that share input and
+ * output dimensions. Architecture-compatible models are blended in weight
+ * space, so a cook costs a single forward pass; other pairs are blended
+ * in output space with both models run tile by tile.
+ */
+
+#pragma once
+
+#include "NeuralNetwork.h"
+#include "DataManager.h"
+#include "AlignedBuffer.h"
+#include <memory>
+#include <vector>
+
+class ModelMorph
+{
+public:
+    ModelMorph();
+
+    // Prepares a morph from 'from' towards 'to'. A copy of 'to' is folded
+    // into the normalized input/output spaces of 'from', so both ends share
+    // the normalization stage set up for 'from'.
+    void setModels(std::shared_ptr<const NeuralNetwork> from, const NormalizationBounds& fromNorm,
+                   std::shared_ptr<const NeuralNetwork> to, const NormalizationBounds& toNorm);
+    void reset();
+
+    const NeuralNetwork* getFrom() const { return m_from.get(); }
+    const NeuralNetwork* getTo() const { return m_toSource.get(); }
+    bool canBlendWeights() const { return m_blended != nullptr; }
+
+    // Rewrites the interpolated weights when 'amount' changed since the last
+    // call and returns the blended network. Requires canBlendWeights().
+    const NeuralNetwork& blendWeights(float amount);
+
+    // (1 - amount) * from(x) + amount * to(x), evaluating both models on each
+    // tile while it is in cache. Same contract as NeuralNetwork::forwardBatch;
+    // 'scratch' must hold getBatchScratchSize() floats.
+    void forwardBlendBatch(float amount, const float* const* inputs, float* const* outputs,
+                           int count, float* scratch,
+                           ActivationPrecision precision = ActivationPrecision::Exact);
+    int getBatchScratchSize() const;
+
+private:
+    std::shared_ptr<const NeuralNetwork> m_from;
+    std::shared_ptr<const NeuralNetwork> m_toSource;
+    std::unique_ptr<NeuralNetwork> m_to;        // m_toSource in m_from's normalized spaces
+    std::unique_ptr<NeuralNetwork> m_blended;   // Set when the architectures match
+    float m_blendedAmount;
+
+    AlignedBuffer m_tileOutputs;                // [2][outputDim][TileWidth]
+    std::vector<const float*> m_tileInputs;
+    std::vector<float*> m_tileFrom;
+    std::vector<float*> m_tileTo;
+};
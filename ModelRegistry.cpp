@@ -0,0 +1,75 @@
+/* TD-NeuroMap Model Registry Implementation */
+
+#include "ModelRegistry.h"
+#include "ModelFile.h"
+#include <vector>
+
+ModelRegistry& ModelRegistry::instance()
+{
+    static ModelRegistry registry;
+    return registry;
+}
+
+std::shared_ptr<const SharedModel> ModelRegistry::acquire(const std::string& path, std::string& error)
+{
+    // Plain reads rather than a mapping, so the file is closed again before
+    // parsing starts. A copy that rewrites it in place mid-read leaves a
+    // short or mixed buffer, which fails validation instead of faulting,
+    // and on Windows the copy is never refused because the file is open.
+    std::vector<char> bytes;
+    if (!ModelFile::readBytes(path, bytes, error))
+    {
+        return nullptr;
+    }
+
+    // Current files carry their checksum, so a model that is already
+    // loaded is found without hashing its weights
+    Key key(path, ModelFile::contentHash(bytes.data(), bytes.size()));
+
+    // Parsing happens under the lock so concurrent requests for the same
+    // file load it exactly once
+    std::lock_guard<std::mutex> lock(m_mutex);
+    purgeExpired();
+
+    auto it = m_models.find(key);
+    if (it != m_models.end())
+    {
+        std::shared_ptr<const SharedModel> existing = it->second.lock();
+        if (existing)
+        {
+            return existing;
+        }
+    }
+
+    std::shared_ptr<SharedModel> model = std::make_shared<SharedModel>();
+    model->path = path;
+    model->contentHash = key.second;
+    std::unique_ptr<NeuralNetwork> folded;
+    model->network = ModelFile::parse(bytes, model->normalization, folded, error);
+    if (!model->network)
+    {
+        return nullptr;
+    }
+    model->folded = std::move(folded);
+
+    m_models[key] = model;
+    return model;
+}
+
+int ModelRegistry::getNumModels()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    purgeExpired();
+    return static_cast<int>(m_models.size());
+}
+
+void ModelRegistry::purgeExpired()
+{
+    for (auto it = m_models.begin(); it != m_models.end();)
+    {
+        if (it->second.expired())
+            it = m_models.erase(it);
+        else
+            ++it;
+    }
+}
\ No newline at end of file
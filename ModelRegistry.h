@@ -0,0 +1,51 @@
+/* TD-NeuroMap Model Registry
+ * Process-wide cache of loaded models shared between NeuroMapCHOP instances
+ */
+
+#pragma once
+
+#include "NeuralNetwork.h"
+#include "DataManager.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+// A loaded model. Immutable once published, so every node holding it can
+// run inference on the same weights without copying them. The weights are
+// owned by the entry; the model file is closed once it is parsed.
+struct SharedModel
+{
+    std::string path;
+    uint64_t contentHash;
+    std::unique_ptr<const NeuralNetwork> network;
+    std::unique_ptr<const NeuralNetwork> folded;    // Raw-space form, null without normalization
+    NormalizationBounds normalization;
+};
+
+class ModelRegistry
+{
+public:
+    static ModelRegistry& instance();
+
+    // Returns the model for 'path', reading and parsing it only if
+    // no live entry has the same path and content hash. Returns nullptr and sets 'error' on
+    // failure. The entry is released when the last holder drops it.
+    std::shared_ptr<const SharedModel> acquire(const std::string& path, std::string& error);
+
+    int getNumModels();
+
+private:
+    ModelRegistry() = default;
+    ModelRegistry(const ModelRegistry&) = delete;
+    ModelRegistry& operator=(const ModelRegistry&) = delete;
+
+    void purgeExpired();
+
+    typedef std::pair<std::string, uint64_t> Key;
+
+    std::mutex m_mutex;
+    std::map<Key, std::weak_ptr<const SharedModel>> m_models;
+};
\ No newline at end of file
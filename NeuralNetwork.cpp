@@ -0,0 +1,321 @@
+/* TD-NeuroMap Neural Network Implementation */
+
+#include "NeuralNetwork.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <utility>
+
+NeuralNetwork::NeuralNetwork(const NetworkArchitecture& arch)
+    : m_arch(arch)
+    , m_data(nullptr)
+    , m_size(0)
+    , m_kernel(nullptr)
+    , m_fastKernel(nullptr)
+    , m_columnsCurrent(false)
+    , m_denseTile(nullptr)
+    , m_fastDenseTile(nullptr)
+{
+    allocateStorage();
+    bindLayers();
+}
+
+NeuralNetwork::NeuralNetwork(const NetworkArchitecture& arch, float* storage, std::shared_ptr<void> owner)
+    : m_arch(arch)
+    , m_data(storage)
+    , m_size(0)
+    , m_owner(std::move(owner))
+    , m_kernel(nullptr)
+    , m_fastKernel(nullptr)
+    , m_columnsCurrent(false)
+    , m_denseTile(nullptr)
+    , m_fastDenseTile(nullptr)
+{
+    m_size = computeOffsets(m_arch, m_offsets);
+    bindLayers();
+}
+
+NeuralNetwork::NeuralNetwork(const NeuralNetwork& other)
+    : m_arch(other.m_arch)
+    , m_data(nullptr)
+    , m_size(0)
+    , m_offsets(other.m_offsets)
+    , m_kernel(nullptr)
+    , m_fastKernel(nullptr)
+    , m_columnsCurrent(false)
+    , m_denseTile(nullptr)
+    , m_fastDenseTile(nullptr)
+{
+    copyStorage(other);
+    bindLayers();
+}
+
+NeuralNetwork& NeuralNetwork::operator=(const NeuralNetwork& other)
+{
+    if (this != &other)
+    {
+        m_arch = other.m_arch;
+        m_offsets = other.m_offsets;
+        copyStorage(other);
+        bindLayers();
+    }
+    return *this;
+}
+
+NeuralNetwork::~NeuralNetwork()
+{
+}
+
+void NeuralNetwork::initializeWeights(uint32_t seed)
+{
+    std::mt19937 rng(seed);
+
+    for (int l = 0; l < getNumLayers(); ++l)
+    {
+        const DenseLayer& layer = m_layers[l];
+        float limit = std::sqrt(6.0f / static_cast<float>(layer.inputs + layer.outputs));
+        std::uniform_real_distribution<float> dist(-limit, limit);
+
+        float* weights = getLayerWeights(l);
+        for (int i = 0; i < layer.inputs * layer.outputs; ++i)
+        {
+            weights[i] = dist(rng);
+        }
+
+        float* bias = getLayerBias(l);
+        for (int j = 0; j < layer.outputs; ++j)
+        {
+            bias[j] = 0.0f;
+        }
+    }
+    updateKernelWeights();
+}
+
+void NeuralNetwork::forward(const float* input, float* output, float* scratch,
+                            ActivationPrecision precision) const
+{
+    ForwardKernelFn kernel = (precision == ActivationPrecision::Fast) ? m_fastKernel : m_kernel;
+    if (kernel && m_columnsCurrent)
+    {
+        kernel(m_columnLayers.data(), getNumLayers(), input, output, scratch);
+    }
+    else
+    {
+        InferenceKernels::forwardGeneric(m_layers.data(), getNumLayers(), input, output, scratch, precision);
+    }
+}
+
+void NeuralNetwork::forwardJacobian(const float* input, float* output, float* jacobian, float* scratch,
+                                    ActivationPrecision precision) const
+{
+    InferenceKernels::forwardJacobian(m_layers.data(), getNumLayers(), input, output, jacobian, scratch,
+                                      precision);
+}
+
+void NeuralNetwork::forwardBatch(const float* const* inputs, float* const* outputs, int count, float* scratch,
+                                 ActivationPrecision precision) const
+{
+    const int tile = SimdKernels::TileWidth;
+    const int numLayers = getNumLayers();
+    SimdKernels::DenseTileFn denseTile = (precision == ActivationPrecision::Fast) ? m_fastDenseTile : m_denseTile;
+
+    float* xTile = scratch;
+    float* hiddenA = xTile + m_arch.inputDim * tile;
+    float* hiddenB = hiddenA + m_arch.hiddenUnits * tile;
+    float* yTile = hiddenB + m_arch.hiddenUnits * tile;
+
+    for (int base = 0; base < count; base += tile)
+    {
+        int lanes = std::min(tile, count - base);
+
+        // Gather the tile; unused lanes are zeroed and discarded afterwards
+        for (int k = 0; k < m_arch.inputDim; ++k)
+        {
+            float* xk = xTile + k * tile;
+            const float* src = inputs[k] + base;
+            for (int lane = 0; lane < lanes; ++lane)
+            {
+                xk[lane] = src[lane];
+            }
+            for (int lane = lanes; lane < tile; ++lane)
+            {
+                xk[lane] = 0.0f;
+            }
+        }
+
+        const float* x = xTile;
+        float* current = hiddenA;
+        float* next = hiddenB;
+        for (int l = 0; l < numLayers - 1; ++l)
+        {
+            denseTile(m_layers[l], x, current, true);
+            x = current;
+            std::swap(current, next);
+        }
+        denseTile(m_layers[numLayers - 1], x, yTile, false);
+
+        for (int j = 0; j < m_arch.outputDim; ++j)
+        {
+            const float* yj = yTile + j * tile;
+            float* dst = outputs[j] + base;
+            for (int lane = 0; lane < lanes; ++lane)
+            {
+                dst[lane] = yj[lane];
+            }
+        }
+    }
+}
+
+int NeuralNetwork::getBatchScratchSize() const
+{
+    return (m_arch.inputDim + 2 * m_arch.hiddenUnits + m_arch.outputDim) * SimdKernels::TileWidth;
+}
+
+float* NeuralNetwork::getLayerWeights(int layer)
+{
+    m_columnsCurrent = false;
+    return m_data + m_offsets[layer].weights;
+}
+
+float* NeuralNetwork::getLayerBias(int layer)
+{
+    m_columnsCurrent = false;
+    return m_data + m_offsets[layer].bias;
+}
+
+void NeuralNetwork::updateKernelWeights()
+{
+    if (!m_kernel)
+    {
+        return;
+    }
+
+    float* packed = m_columns.data();
+    for (size_t l = 0; l < m_layers.size(); ++l)
+    {
+        m_columnLayers[l] = InferenceKernels::packColumns(m_layers[l], packed);
+        packed += InferenceKernels::getColumnSize(m_layers[l]);
+    }
+    m_columnsCurrent = true;
+}
+
+void NeuralNetwork::foldInputAffine(const float* scale, const float* offset)
+{
+    const DenseLayer& first = m_layers.front();
+    float* weights = getLayerWeights(0);
+    float* bias = getLayerBias(0);
+    for (int j = 0; j < first.outputs; ++j)
+    {
+        float* row = weights + j * first.inputs;
+        for (int k = 0; k < first.inputs; ++k)
+        {
+            bias[j] += row[k] * offset[k];
+            row[k] *= scale[k];
+        }
+    }
+    updateKernelWeights();
+}
+
+void NeuralNetwork::foldOutputAffine(const float* scale, const float* offset)
+{
+    const int lastIndex = getNumLayers() - 1;
+    const DenseLayer& last = m_layers[lastIndex];
+    float* weights = getLayerWeights(lastIndex);
+    float* bias = getLayerBias(lastIndex);
+    for (int j = 0; j < last.outputs; ++j)
+    {
+        float* row = weights + j * last.inputs;
+        for (int k = 0; k < last.inputs; ++k)
+        {
+            row[k] *= scale[j];
+        }
+        bias[j] = bias[j] * scale[j] + offset[j];
+    }
+    updateKernelWeights();
+}
+
+size_t NeuralNetwork::getStorageSize(const NetworkArchitecture& arch)
+{
+    std::vector<LayerOffsets> offsets;
+    return computeOffsets(arch, offsets);
+}
+
+size_t NeuralNetwork::computeOffsets(const NetworkArchitecture& arch, std::vector<LayerOffsets>& offsets)
+{
+    // Layer sizes: input -> hidden, (hiddenLayers - 1) x hidden -> hidden, hidden -> output
+    std::vector<int> sizes;
+    sizes.push_back(arch.inputDim);
+    for (int l = 0; l < arch.hiddenLayers; ++l)
+    {
+        sizes.push_back(arch.hiddenUnits);
+    }
+    sizes.push_back(arch.outputDim);
+
+    offsets.clear();
+    size_t total = 0;
+    for (size_t l = 0; l + 1 < sizes.size(); ++l)
+    {
+        LayerOffsets layer;
+        layer.weights = total;
+        total += AlignedBuffer::padToLine(static_cast<size_t>(sizes[l]) * sizes[l + 1]);
+        layer.bias = total;
+        total += AlignedBuffer::padToLine(static_cast<size_t>(sizes[l + 1]));
+        offsets.push_back(layer);
+    }
+    return total;
+}
+
+void NeuralNetwork::allocateStorage()
+{
+    m_size = computeOffsets(m_arch, m_offsets);
+    m_storage.resize(m_size);
+    m_data = m_storage.data();
+}
+
+void NeuralNetwork::copyStorage(const NeuralNetwork& other)
+{
+    m_owner.reset();
+    m_storage.resize(other.m_size);
+    m_size = other.m_size;
+    m_data = m_storage.data();
+    if (m_size > 0)
+    {
+        std::memcpy(m_data, other.m_data, m_size * sizeof(float));
+    }
+}
+
+void NeuralNetwork::bindLayers()
+{
+    m_layers.clear();
+    for (size_t l = 0; l < m_offsets.size(); ++l)
+    {
+        DenseLayer layer;
+        layer.inputs = (l == 0) ? m_arch.inputDim : m_arch.hiddenUnits;
+        layer.outputs = (l + 1 == m_offsets.size()) ? m_arch.outputDim : m_arch.hiddenUnits;
+        layer.weights = m_data + m_offsets[l].weights;
+        layer.bias = m_data + m_offsets[l].bias;
+        m_layers.push_back(layer);
+    }
+
+    // The specialized kernel follows from the shape alone, so both variants
+    // are bound here and their column-major weights packed once
+    m_kernel = SimdKernels::getForwardKernel(m_arch.inputDim, m_arch.hiddenUnits, m_arch.outputDim,
+                                             ActivationPrecision::Exact);
+    m_fastKernel = SimdKernels::getForwardKernel(m_arch.inputDim, m_arch.hiddenUnits, m_arch.outputDim,
+                                                 ActivationPrecision::Fast);
+    m_denseTile = SimdKernels::getDenseTileKernel(ActivationPrecision::Exact);
+    m_fastDenseTile = SimdKernels::getDenseTileKernel(ActivationPrecision::Fast);
+
+    size_t columnSize = 0;
+    if (m_kernel)
+    {
+        for (const DenseLayer& layer : m_layers)
+        {
+            columnSize += InferenceKernels::getColumnSize(layer);
+        }
+    }
+    m_columns.resize(columnSize);
+    m_columnLayers.resize(m_layers.size());
+    updateKernelWeights();
+}
\ No newline at end of file
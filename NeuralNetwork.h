@@ -0,0 +1,128 @@
+/* TD-NeuroMap Neural Network
+ * Multi-layer perceptron weights and forward pass
+ */
+
+#pragma once
+
+#include "AlignedBuffer.h"
+#include "InferenceKernels.h"
+#include "SimdKernels.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct NetworkArchitecture
+{
+    int inputDim = 2;
+    int outputDim = 2;
+    int hiddenUnits = 64;
+    int hiddenLayers = 2;
+
+    bool operator==(const NetworkArchitecture& other) const
+    {
+        return inputDim == other.inputDim && outputDim == other.outputDim &&
+               hiddenUnits == other.hiddenUnits && hiddenLayers == other.hiddenLayers;
+    }
+    bool operator!=(const NetworkArchitecture& other) const { return !(*this == other); }
+};
+
+class NeuralNetwork
+{
+public:
+    explicit NeuralNetwork(const NetworkArchitecture& arch);
+
+    // Runs on 'storage' in place instead of allocating its own. 'storage'
+    // must be 64-byte aligned and hold getStorageSize(arch) floats in the
+    // layout getStorage() exposes; 'owner' keeps it alive. Copies of the
+    // network own their weights again.
+    NeuralNetwork(const NetworkArchitecture& arch, float* storage, std::shared_ptr<void> owner);
+
+    NeuralNetwork(const NeuralNetwork& other);
+    NeuralNetwork& operator=(const NeuralNetwork& other);
+    ~NeuralNetwork();
+
+    // Weight initialization (Xavier uniform, zero bias)
+    void initializeWeights(uint32_t seed);
+
+    // Inference
+    // 'scratch' must hold getScratchSize() floats. Every pass takes the
+    // hidden-layer tanh precision; both kernel variants are bound up front.
+    // Shapes with a specialized kernel run it on a column-major copy of the
+    // weights, which writes through getStorage(), getLayerWeights() or
+    // getLayerBias() leave stale: forward() takes the generic path until
+    // updateKernelWeights() refreshes the copy.
+    void forward(const float* input, float* output, float* scratch,
+                 ActivationPrecision precision = ActivationPrecision::Exact) const;
+    int getScratchSize() const { return 2 * m_arch.hiddenUnits; }
+    bool hasSpecializedKernel(ActivationPrecision precision = ActivationPrecision::Exact) const
+    {
+        return (precision == ActivationPrecision::Fast ? m_fastKernel : m_kernel) != nullptr;
+    }
+    void updateKernelWeights();
+
+    // Single-sample inference that also writes d(output)/d(input) as
+    // jacobian[outputDim][inputDim]; 'scratch' must hold
+    // getJacobianScratchSize() floats
+    void forwardJacobian(const float* input, float* output, float* jacobian, float* scratch,
+                         ActivationPrecision precision = ActivationPrecision::Exact) const;
+    int getJacobianScratchSize() const { return 2 * m_arch.hiddenUnits * (m_arch.inputDim + 1); }
+
+    // Batched inference over 'count' samples. Inputs and outputs are
+    // channel-major ([dim][sample]), matching CHOP channel data.
+    // 'scratch' must hold getBatchScratchSize() floats, 64-byte aligned.
+    void forwardBatch(const float* const* inputs, float* const* outputs, int count, float* scratch,
+                      ActivationPrecision precision = ActivationPrecision::Exact) const;
+    int getBatchScratchSize() const;
+
+    // Architecture and weight access
+    const NetworkArchitecture& getArchitecture() const { return m_arch; }
+    int getNumLayers() const { return static_cast<int>(m_layers.size()); }
+    const DenseLayer* getLayers() const { return m_layers.data(); }
+    float* getLayerWeights(int layer);
+    float* getLayerBias(int layer);
+
+    // Absorb per-dimension affine maps into the first/last layer so the
+    // network computes f(scale * x + offset) and scale * f(x) + offset
+    void foldInputAffine(const float* scale, const float* offset);
+    void foldOutputAffine(const float* scale, const float* offset);
+
+    // Whole weight storage, one cache-aligned block per weight/bias array
+    float* getStorage()
+    {
+        m_columnsCurrent = false;
+        return m_data;
+    }
+    const float* getStorage() const { return m_data; }
+    size_t getStorageSize() const { return m_size; }
+    bool hasExternalStorage() const { return m_owner != nullptr; }
+
+    // Float count of the weight storage of 'arch'
+    static size_t getStorageSize(const NetworkArchitecture& arch);
+
+private:
+    struct LayerOffsets
+    {
+        size_t weights;
+        size_t bias;
+    };
+
+    NetworkArchitecture m_arch;
+    AlignedBuffer m_storage;
+    float* m_data;                      // m_storage, or the external storage
+    size_t m_size;
+    std::shared_ptr<void> m_owner;      // Keeps external storage alive
+    std::vector<LayerOffsets> m_offsets;
+    std::vector<DenseLayer> m_layers;
+    ForwardKernelFn m_kernel;
+    ForwardKernelFn m_fastKernel;
+    AlignedBuffer m_columns;            // Column-major weights of the specialized kernels
+    std::vector<DenseLayer> m_columnLayers;
+    bool m_columnsCurrent;              // m_columns matches the weights
+    SimdKernels::DenseTileFn m_denseTile;
+    SimdKernels::DenseTileFn m_fastDenseTile;
+
+    static size_t computeOffsets(const NetworkArchitecture& arch, std::vector<LayerOffsets>& offsets);
+    void allocateStorage();
+    void copyStorage(const NeuralNetwork& other);
+    void bindLayers();
+};
\ No newline at end of file
@@ -8,6 +8,23 @@
 #include "CHOP_CPlusPlusBase.h"
 #include "Parameters.h"
 #include "DataManager.h"
+#include "NeuralNetwork.h"
+#include "QuantizedNetwork.h"
+#include "BakedLUT.h"
+#include "ModelBank.h"
+#include "ModelMorph.h"
+#include "CookWatchdog.h"
+#include "SparseNetwork.h"
+#include "Trainer.h"
+#include "OutputFilterBank.h"
+#include "Upsampler.h"
+#include "BackgroundJobs.h"
+#include "FileWatcher.h"
+#include "ModelRegistry.h"
+#include "DatasetFile.h"
+#include "ProjectBundle.h"
+#include <array>
+#include <chrono>
 #include <memory>
 
 using namespace TD;
@@ -23,12 +40,28 @@ public:
     virtual bool getOutputInfo(CHOP_OutputInfo* info, const OP_Inputs* inputs, void*) override;
     virtual void getChannelName(int32_t index, OP_String* name, const OP_Inputs* inputs, void*) override;
     virtual void execute(CHOP_Output* output, const OP_Inputs* inputs, void*) override;
+    virtual int32_t getNumInfoCHOPChans(void*) override;
+    virtual void getInfoCHOPChan(int32_t index, OP_InfoCHOPChan* chan, void*) override;
+    virtual void getWarningString(OP_String* warning, void*) override;
     virtual void setupParameters(OP_ParameterManager* manager, void*) override;
     virtual void pulsePressed(const char* name, void*) override;
 
 private:
     // Core components
     std::unique_ptr<DataManager> m_dataManager;
+    std::shared_ptr<const NeuralNetwork> m_network;   // May be shared through ModelRegistry
+    std::shared_ptr<const NeuralNetwork> m_folded;    // m_network with m_normalization folded in, null without it
+    NormalizationBounds m_normalization;              // The bounds m_network was trained with; the dataset keeps its own
+    std::shared_ptr<const QuantizedNetwork> m_quantized;  // Set while Precision is Int8
+    std::shared_ptr<const BakedLUT> m_lut;                // Set by Bake LUT for the current network
+    std::shared_ptr<const SparseNetwork> m_sparse;        // Set by weight pruning when it beats the dense kernels; folded like m_folded
+    ModelBank m_bank;                                 // Slots keep the three forms above for their models
+    ModelMorph m_morph;
+    CookWatchdog m_watchdog;
+    OutputFilterBank m_smoothing;                     // One filter per mapped output channel
+    Upsampler m_upsampler;
+    BackgroundJobs m_fileJobs;                        // Model, dataset and bundle saves/loads, reload checks, LUT bakes, int8 builds, training, pruning and distillation
+    std::shared_ptr<FileWatcher> m_modelWatcher;      // Shared with the reload check jobs
     Parameters m_params;
 
     // State management
@@ -36,17 +69,179 @@ private:
     int m_currentInputDim;
     int m_currentOutputDim;
     bool m_modelTrained;
+    InstanceModeMenuItems m_instanceMode;
+    int m_numInstances;
+    bool m_jacobianEnabled;                           // Indim x Outdim extra channels in Run mode
+    bool m_saveRequested;
+    bool m_loadRequested;
+    bool m_bakeRequested;
+    bool m_useLut;
+    int m_activeSlot;                                 // Bank slot serving Run mode, -1 for none
+    int m_requestedSlot;                              // Bank index last selected, -1 to select again
+    bool m_storeRequested;
+    bool m_saveBankRequested;
+    bool m_loadBankRequested;
+    std::string m_watchedModelPath;                   // Empty while Reload Model On Change is off
+    bool m_reloadCheckPending;
+    bool m_int8Pending;                               // An int8 model is being built on the worker
+    std::chrono::steady_clock::time_point m_lastReloadCheck;
+    bool m_saveDatasetRequested;
+    bool m_loadDatasetRequested;
+    bool m_saveBundleRequested;
+    bool m_loadBundleRequested;
+    MorphModeMenuItems m_morphMode;                   // Blend serving Run mode, Off when not morphing
+    float m_morphAmount;
+    bool m_useInt8;                                   // Precision is Int8 (m_quantized may also back the watchdog)
+    ActivationPrecision m_activation;                 // Hidden-layer tanh used by training and every Run path
+    bool m_smoothEnabled;                             // The previous Run cook was smoothed
+    bool m_upsampling;                                // Run mode emits an audio-rate timeslice
+    std::vector<float> m_upsampleTarget;              // This frame's result, one value per output
+    std::vector<float*> m_upsampleTargetChannels;     // One-sample channel views of m_upsampleTarget
+    bool m_ranInference;                              // This cook mapped the input
+    bool m_ranFallback;                               // ... through the watchdog's fallback
+    BudgetFallbackMenuItems m_fallbackPath;
+    bool m_modelJobPending;                           // Training, pruning or distillation runs on the worker
+    bool m_pruneRequested;
+    float m_pruneSpeedup;                             // Dense / pruned batch time of the last prune
+    float m_pruneLossDelta;                           // Loss after pruning and fine-tuning minus loss before
+    bool m_distillRequested;
+    float m_distillFidelity;                          // Student vs teacher RMS error on held-out samples
+    float m_distillSpeedup;                           // Teacher / student batch time
+
+    // Inference buffers, sized when the network is created. Run mode cooks
+    // only read and write these; they never resize on the hot path.
+    std::vector<float> m_inputBuffer;
+    std::vector<float> m_outputBuffer;
+    std::vector<float> m_forwardScratch;
+    AlignedBuffer m_chunkInput;                      // [inputDim][RunChunk]
+    AlignedBuffer m_chunkOutput;                     // [outputDim][RunChunk]
+    std::vector<const float*> m_chunkInputChannels;
+    std::vector<float*> m_chunkOutputChannels;
+    AlignedBuffer m_chunkJacobian;                   // [outputDim * inputDim][RunChunk]
+    std::vector<float> m_jacobianBuffer;
+    std::vector<float> m_jacobianScratch;
+    AlignedBuffer m_batchScratch;
+    AlignedBuffer m_quantizedScratch;
     
+    // Last Run-mode result, reused while the input block is unchanged
+    struct InferenceCache
+    {
+        bool valid = false;
+        bool reused = false;                // Whether the last cook skipped inference
+        int64_t inputCooks = -1;
+        InstanceModeMenuItems instanceMode = InstanceModeMenuItems::Off;
+        int numInputChannels = 0;
+        int numInputSamples = 0;
+        int numOutputChannels = 0;
+        int numOutputSamples = 0;
+        std::vector<float> input;           // [channel][sample]
+        std::vector<float> output;          // [channel][sample]
+    };
+    InferenceCache m_cache;
+
+    // Filled by a background file job, read by its completion
+    struct FileJobResult
+    {
+        bool succeeded = false;
+        std::string error;
+        std::shared_ptr<const SharedModel> model;
+        DatasetFile::Samples inputs;
+        DatasetFile::Samples targets;
+        ProjectBundle::Contents bundle;
+        std::unique_ptr<BakedLUT> lut;
+        std::shared_ptr<const QuantizedNetwork> quantized;
+        std::shared_ptr<ModelBank> bank;
+        double millis = 0.0;
+        double speedup = 0.0;
+    };
+
+    // Filled by a background training, pruning or distillation job, read
+    // by its completion
+    struct ModelJobResult
+    {
+        std::shared_ptr<const NeuralNetwork> network;
+        std::shared_ptr<const NeuralNetwork> folded;    // Raw-space form, null without normalization
+        std::shared_ptr<const SparseNetwork> sparse;    // Built from 'folded' when there is one
+        float speedup = 0.0f;
+        float lossDelta = 0.0f;
+        float fidelity = 0.0f;
+        std::string message;                            // Logged when the result is installed
+    };
+
     // Internal methods
     void handleModeChange(ModeMenuItems newMode, const OP_Inputs* inputs);
     void handleDataCollection(const OP_Inputs* inputs);
     void handleTraining(const OP_Inputs* inputs);
+    void buildTrainingSet(const NetworkArchitecture& arch, const NormalizationBounds& normalization,
+                          Dataset& inputs, Dataset& targets) const;
+    void handlePrune(const OP_Inputs* inputs);
+    void handleDistill(const OP_Inputs* inputs);
+    void getInputRange(const NetworkArchitecture& arch, std::vector<float>& lower, std::vector<float>& upper) const;
     void handleInference(const OP_Inputs* inputs, CHOP_Output* output);
+    void handleInstanceInference(const OP_CHOPInput* inputCHOP, CHOP_Output* output);
+    int countInstances(const OP_CHOPInput* inputCHOP) const;
+    // gather(channel, start, count, block) fills raw input values, and
+    // scatter(channel, start, count, block) receives denormalized outputs;
+    // with 'withJacobian' it also receives d(out j)/d(in k) in raw units as
+    // channel outputDim + j * inputDim + k
+    template <typename Gather, typename Scatter>
+    void runPipeline(int count, Gather gather, Scatter scatter, bool withJacobian = false);
+    bool matchesCachedShape(const OP_CHOPInput* inputCHOP, const CHOP_Output* output) const;
+    bool matchesCachedInput(const OP_CHOPInput* inputCHOP, const CHOP_Output* output);
+    void restoreCachedOutput(CHOP_Output* output) const;
+    void storeCachedOutput(const OP_CHOPInput* inputCHOP, const CHOP_Output* output);
+    void runForwardBatch(const float* const* inputs, float* const* outputs, int count);
+    void runForwardJacobian(const float* const* inputs, float* const* outputs, int count);
+    void runNetwork(const NeuralNetwork& network, const float* const* inputs, float* const* outputs, int count);
+    void updatePrecision(const OP_Inputs* inputs);
+    bool wantsInt8(const OP_Inputs* inputs) const;
+    void updateActivation(const OP_Inputs* inputs);
+    void smoothOutput(const OP_Inputs* inputs, float* const* channels, int numChannels, int numSamples,
+                      float sampleRate);
+    bool wantsUpsampling(const OP_Inputs* inputs) const;
+    void runUpsampled(const OP_Inputs* inputs, const OP_CHOPInput* inputCHOP, CHOP_Output* output);
+    BudgetFallbackMenuItems resolveFallback(const OP_Inputs* inputs) const;
+    void updateRunSource(const OP_Inputs* inputs);
+    void handleBake(const OP_Inputs* inputs);
+    // 'network' was trained with 'normalization'; 'folded' is its raw-space
+    // form, which setNetwork builds from the two when it is not given
+    void setNetwork(std::shared_ptr<const NeuralNetwork> network, const NormalizationBounds& normalization,
+                    std::shared_ptr<const NeuralNetwork> folded = nullptr);
+    void activateNetwork(const BankSlot& model);
+    bool runsFolded() const;
+    void reserveBuffers(const NeuralNetwork& network);
+    void reserveBuffers(const BankSlot& model);
+    void handleBank(const OP_Inputs* inputs);
+    void saveBank(const std::string& path);
+    void loadBank(const std::string& path, const OP_Inputs* inputs);
+    void keepDerivedInBank();
+    void selectBankSlot(const OP_Inputs* inputs);
+    void updateMorph(const OP_Inputs* inputs);
+    void handleModelFile(const OP_Inputs* inputs);
+    void saveModel(const std::string& path);
+    void loadModel(const std::string& path);
+    void applyModel(const std::string& path, const std::shared_ptr<const SharedModel>& model);
+    void installModel(const std::shared_ptr<const SharedModel>& model);
+    void handleHotReload(const OP_Inputs* inputs);
+    void handleDatasetFile(const OP_Inputs* inputs);
+    void saveDataset(const std::string& path);
+    void loadDataset(const std::string& path);
+    void handleBundleFile(const OP_Inputs* inputs);
+    ProjectBundle::Settings readSettings(const OP_Inputs* inputs) const;
+    void saveBundle(const OP_Inputs* inputs, const std::string& path);
+    void loadBundle(const OP_Inputs* inputs, const std::string& path);
+    void applyBundle(const std::string& path, ProjectBundle::Contents& bundle,
+                     const ProjectBundle::Settings& current);
     
     // Parameter helpers
     void updateReadOnlyParams(const OP_Inputs* inputs);
     bool validateInputs(const OP_Inputs* inputs) const;
     
+#ifndef NDEBUG
+    typedef std::array<const void*, 12> ScratchPointers;
+    ScratchPointers getScratchPointers() const;
+#endif
+
     // Utility methods
     std::string generateChannelName(bool isInput, int index) const;
     void logMessage(const std::string& message) const;
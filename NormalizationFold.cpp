@@ -0,0 +1,117 @@
+/* TD-NeuroMap Normalization Fold Implementation */
+
+#include "NormalizationFold.h"
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    // Same degenerate-range threshold as NormalizationBounds::normalizeInput
+    const float MinRange = 1e-6f;
+
+    bool isDegenerate(float minVal, float maxVal)
+    {
+        return std::abs(maxVal - minVal) < MinRange;
+    }
+}
+
+bool NormalizationFold::matches(const NetworkArchitecture& arch, const NormalizationBounds& bounds)
+{
+    return !bounds.empty() &&
+           bounds.inputMin.size() == static_cast<size_t>(arch.inputDim) &&
+           bounds.inputMax.size() == static_cast<size_t>(arch.inputDim) &&
+           bounds.outputMin.size() == static_cast<size_t>(arch.outputDim) &&
+           bounds.outputMax.size() == static_cast<size_t>(arch.outputDim);
+}
+
+void NormalizationFold::fold(NeuralNetwork& network, const NormalizationBounds& bounds)
+{
+    const NetworkArchitecture& arch = network.getArchitecture();
+
+    // x_n = (x - min) / range, or 0.5 for a degenerate range
+    std::vector<float> scale(arch.inputDim), offset(arch.inputDim);
+    for (int k = 0; k < arch.inputDim; ++k)
+    {
+        float minVal = bounds.inputMin[k];
+        float maxVal = bounds.inputMax[k];
+        if (isDegenerate(minVal, maxVal))
+        {
+            scale[k] = 0.0f;
+            offset[k] = 0.5f;
+        }
+        else
+        {
+            scale[k] = 1.0f / (maxVal - minVal);
+            offset[k] = -minVal / (maxVal - minVal);
+        }
+    }
+    network.foldInputAffine(scale.data(), offset.data());
+
+    // y = y_n * range + min
+    scale.resize(arch.outputDim);
+    offset.resize(arch.outputDim);
+    for (int j = 0; j < arch.outputDim; ++j)
+    {
+        scale[j] = bounds.outputMax[j] - bounds.outputMin[j];
+        offset[j] = bounds.outputMin[j];
+    }
+    network.foldOutputAffine(scale.data(), offset.data());
+}
+
+void NormalizationFold::unfold(NeuralNetwork& network, const NormalizationBounds& bounds)
+{
+    const NetworkArchitecture& arch = network.getArchitecture();
+
+    // x = (x_n - offset) / scale, the inverse of the input map in fold()
+    std::vector<float> scale(arch.inputDim), offset(arch.inputDim);
+    for (int k = 0; k < arch.inputDim; ++k)
+    {
+        float minVal = bounds.inputMin[k];
+        float maxVal = bounds.inputMax[k];
+        if (isDegenerate(minVal, maxVal))
+        {
+            scale[k] = 0.0f;
+            offset[k] = 0.0f;
+        }
+        else
+        {
+            scale[k] = maxVal - minVal;
+            offset[k] = minVal;
+        }
+    }
+    network.foldInputAffine(scale.data(), offset.data());
+
+    // y_n = (y - min) / range; a degenerate output is constant, and
+    // DataManager normalizes it to 0.5
+    scale.resize(arch.outputDim);
+    offset.resize(arch.outputDim);
+    for (int j = 0; j < arch.outputDim; ++j)
+    {
+        float minVal = bounds.outputMin[j];
+        float maxVal = bounds.outputMax[j];
+        if (isDegenerate(minVal, maxVal))
+        {
+            scale[j] = 0.0f;
+            offset[j] = 0.5f;
+        }
+        else
+        {
+            scale[j] = 1.0f / (maxVal - minVal);
+            offset[j] = -minVal / (maxVal - minVal);
+        }
+    }
+    network.foldOutputAffine(scale.data(), offset.data());
+}
+
+std::shared_ptr<const NeuralNetwork> NormalizationFold::makeFolded(const NeuralNetwork& network,
+                                                                    const NormalizationBounds& bounds)
+{
+    if (!matches(network.getArchitecture(), bounds))
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<NeuralNetwork> folded = std::make_shared<NeuralNetwork>(network);
+    fold(*folded, bounds);
+    return folded;
+}
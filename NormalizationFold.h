@@ -0,0 +1,32 @@
+/* TD-NeuroMap Normalization Fold
+ * Absorbs the min/max input normalization and output denormalization into
+ * a network's first and last layers, so a raw input block maps to raw
+ * outputs in one fused pass with no per-element divide.
+ */
+
+#pragma once
+
+#include "NeuralNetwork.h"
+#include "DataManager.h"
+#include <memory>
+
+namespace NormalizationFold
+{
+    // Whether 'bounds' covers every input and output of 'arch'
+    bool matches(const NetworkArchitecture& arch, const NormalizationBounds& bounds);
+
+    // Network-space weights -> raw-space weights, in place. Matches
+    // DataManager exactly, including the constant 0.5 it produces for
+    // inputs with a degenerate range.
+    void fold(NeuralNetwork& network, const NormalizationBounds& bounds);
+
+    // Raw-space weights -> network-space weights, in place. Columns of
+    // degenerate inputs come back as zero, their constant contribution
+    // staying in the bias, which gives the same outputs.
+    void unfold(NeuralNetwork& network, const NormalizationBounds& bounds);
+
+    // Folded copy of a network-space model, or nullptr when 'bounds' does
+    // not match (the model then runs unnormalized and needs no fold)
+    std::shared_ptr<const NeuralNetwork> makeFolded(const NeuralNetwork& network,
+                                                    const NormalizationBounds& bounds);
+}
@@ -0,0 +1,192 @@
+/* TD-NeuroMap Output Filter Bank Implementation */
+
+#include "OutputFilterBank.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    const float TwoPi = 6.28318530717958647692f;
+
+    // Exponential smoothing factor of a first-order low-pass
+    float lowPassAlpha(float cutoff, float dt)
+    {
+        float r = TwoPi * cutoff * dt;
+        return r / (r + 1.0f);
+    }
+
+    // Smoothing factor of a lag with time constant 'tau'; zero means no lag
+    float lagAlpha(float tau, float dt)
+    {
+        return tau > 0.0f ? 1.0f - std::exp(-dt / tau) : 1.0f;
+    }
+
+    // The batched kernels below are branch-free over contiguous rows so
+    // the compiler vectorizes them; OneEuro has hand-written SIMD kernels
+    // in SimdKernels because of its per-channel divide
+
+    // value += clamp(x - value, -maxStep, maxStep)
+    void slewBatch(float* x, float* value, int count, float maxStep)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            const float v = value[i] + std::min(maxStep, std::max(-maxStep, x[i] - value[i]));
+            value[i] = v;
+            x[i] = v;
+        }
+    }
+
+    // One-pole low-pass whose factor depends on the direction of travel
+    void lagBatch(float* x, float* value, int count, float alphaUp, float alphaDown)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            const float delta = x[i] - value[i];
+            const float v = value[i] + (delta > 0.0f ? alphaUp : alphaDown) * delta;
+            value[i] = v;
+            x[i] = v;
+        }
+    }
+
+    // Constant-velocity predict, then correct with the shared gain
+    void kalmanBatch(float* x, float* position, float* velocity, int count,
+                     float dt, float gainPosition, float gainVelocity)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            const float predicted = position[i] + dt * velocity[i];
+            const float residual = x[i] - predicted;
+            const float p = predicted + gainPosition * residual;
+            position[i] = p;
+            velocity[i] += gainVelocity * residual;
+            x[i] = p;
+        }
+    }
+}
+
+OutputFilterBank::OutputFilterBank()
+    : m_numChannels(0)
+    , m_stride(0)
+    , m_primed(false)
+    , m_oneEuro(SimdKernels::getOneEuroKernel())
+    , m_p00(0.0)
+    , m_p01(0.0)
+    , m_p11(0.0)
+{
+}
+
+void OutputFilterBank::configure(const OutputFilterSettings& settings)
+{
+    if (settings.type != m_settings.type)
+    {
+        m_primed = false;
+    }
+    m_settings = settings;
+}
+
+void OutputFilterBank::resize(int numChannels)
+{
+    if (numChannels != m_numChannels)
+    {
+        m_numChannels = numChannels;
+        m_stride = AlignedBuffer::padToLine(static_cast<size_t>(numChannels));
+        m_state.resize(NumStateRows * m_stride);
+        m_frame.resize(numChannels);
+        m_primed = false;
+    }
+}
+
+void OutputFilterBank::filterFrame(float* frame, float dt)
+{
+    if (!m_primed)
+    {
+        prime(frame);
+        return;
+    }
+
+    float* value = row(ValueRow);
+    if (!(dt > 0.0f))
+    {
+        std::copy(value, value + m_numChannels, frame);
+        return;
+    }
+
+    switch (m_settings.type)
+    {
+        case OutputFilterType::OneEuro:
+        {
+            SimdKernels::OneEuroStep step;
+            step.dt = dt;
+            step.minCutoff = m_settings.minCutoff;
+            step.beta = m_settings.beta;
+            step.derivativeAlpha = lowPassAlpha(DerivativeCutoff, dt);
+            m_oneEuro(frame, value, row(RateRow), m_numChannels, step);
+            break;
+        }
+
+        case OutputFilterType::Slew:
+            slewBatch(frame, value, m_numChannels, m_settings.slewRate * dt);
+            break;
+
+        case OutputFilterType::Lag:
+            lagBatch(frame, value, m_numChannels,
+                     lagAlpha(m_settings.lagUp, dt), lagAlpha(m_settings.lagDown, dt));
+            break;
+
+        case OutputFilterType::Kalman:
+            stepKalman(frame, dt);
+            break;
+    }
+}
+
+void OutputFilterBank::filterChannels(float* const* channels, int numSamples, float dt)
+{
+    float* frame = m_frame.data();
+    for (int s = 0; s < numSamples; ++s)
+    {
+        for (int c = 0; c < m_numChannels; ++c)
+        {
+            frame[c] = channels[c][s];
+        }
+
+        filterFrame(frame, dt);
+
+        for (int c = 0; c < m_numChannels; ++c)
+        {
+            channels[c][s] = frame[c];
+        }
+    }
+}
+
+void OutputFilterBank::prime(const float* frame)
+{
+    std::copy(frame, frame + m_numChannels, row(ValueRow));
+    std::fill(row(RateRow), row(RateRow) + m_numChannels, 0.0f);
+
+    // Position is known to the measurement noise, velocity starts at rest
+    m_p00 = m_settings.measurementNoise;
+    m_p01 = 0.0;
+    m_p11 = 0.0;
+    m_primed = true;
+}
+
+void OutputFilterBank::stepKalman(float* frame, float dt)
+{
+    // Predict: P = F P F^T + Q, F = [1 dt; 0 1], Q from white acceleration noise
+    const double t = dt;
+    const double q = m_settings.processNoise;
+    const double p00 = m_p00 + 2.0 * t * m_p01 + t * t * m_p11 + q * t * t * t / 3.0;
+    const double p01 = m_p01 + t * m_p11 + q * t * t / 2.0;
+    const double p11 = m_p11 + q * t;
+
+    // Correct with a position measurement
+    const double s = p00 + m_settings.measurementNoise;
+    const double k0 = s > 0.0 ? p00 / s : 1.0;
+    const double k1 = s > 0.0 ? p01 / s : 0.0;
+    m_p00 = (1.0 - k0) * p00;
+    m_p01 = (1.0 - k0) * p01;
+    m_p11 = p11 - k1 * p01;
+
+    kalmanBatch(frame, row(ValueRow), row(RateRow), m_numChannels, dt,
+                static_cast<float>(k0), static_cast<float>(k1));
+}
@@ -0,0 +1,88 @@
+/* TD-NeuroMap Output Filter Bank
+ * Per-channel filter stage applied to Run-mode outputs: OneEuro (Casiez
+ * et al.), slew limiting, asymmetric lag and a constant-velocity Kalman
+ * filter. The state of every channel lives in one SoA buffer, and each
+ * filter type updates all channels of a frame in one batched pass.
+ */
+
+#pragma once
+
+#include "AlignedBuffer.h"
+#include "SimdKernels.h"
+
+enum class OutputFilterType
+{
+    OneEuro = 0,
+    Slew = 1,
+    Lag = 2,
+    Kalman = 3
+};
+
+struct OutputFilterSettings
+{
+    OutputFilterType type = OutputFilterType::OneEuro;
+    float minCutoff = 1.0f;         // OneEuro, Hz
+    float beta = 0.0f;              // OneEuro speed coefficient
+    float slewRate = 1.0f;          // Slew, units per second
+    float lagUp = 0.1f;             // Lag time constant while rising, seconds
+    float lagDown = 0.1f;           // ... while falling
+    float processNoise = 1.0f;      // Kalman acceleration noise, units^2 / s^3
+    float measurementNoise = 0.01f; // Kalman, units^2
+};
+
+class OutputFilterBank
+{
+public:
+    // Cutoff of the OneEuro derivative low-pass, the value recommended by the paper
+    static constexpr float DerivativeCutoff = 1.0f;
+
+    OutputFilterBank();
+
+    // Changing the filter type resets every channel
+    void configure(const OutputFilterSettings& settings);
+
+    // A different channel count resets every channel
+    void resize(int numChannels);
+
+    // The next frame primes the filters with its values
+    void reset() { m_primed = false; }
+
+    // Filters one frame of getNumChannels() values in place, 'dt' seconds
+    // after the previous frame. A frame with no elapsed time holds the
+    // current estimate.
+    void filterFrame(float* frame, float dt);
+
+    // Filters channels[c][s] in place, sample by sample, for every channel
+    // of the bank; consecutive samples are 'dt' seconds apart
+    void filterChannels(float* const* channels, int numSamples, float dt);
+
+    int getNumChannels() const { return m_numChannels; }
+
+private:
+    // Rows of m_state, each getNumChannels() wide (padded to a cache line).
+    // Row 0 is the filtered value for every type.
+    enum StateRow
+    {
+        ValueRow = 0,
+        RateRow = 1,        // OneEuro derivative estimate, Kalman velocity
+        NumStateRows = 2
+    };
+
+    OutputFilterSettings m_settings;
+    int m_numChannels;
+    size_t m_stride;
+    bool m_primed;
+    AlignedBuffer m_state;      // [NumStateRows][m_stride]
+    AlignedBuffer m_frame;      // One gathered frame for filterChannels
+    SimdKernels::OneEuroFn m_oneEuro;
+
+    // Kalman error covariance. Every channel sees the same time steps and
+    // noise settings, so the covariance and gain are shared by the bank.
+    double m_p00;
+    double m_p01;
+    double m_p11;
+
+    float* row(StateRow index) { return m_state.data() + index * m_stride; }
+    void prime(const float* frame);
+    void stepKalman(float* frame, float dt);
+};
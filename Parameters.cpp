@@ -30,6 +30,11 @@ bool Parameters::evalNormalize(const TD::OP_Inputs* inputs)
     return inputs->getParInt(NormalizeName) ? true : false;
 }
 
+ActivationMenuItems Parameters::evalActivation(const TD::OP_Inputs* inputs)
+{
+    return static_cast<ActivationMenuItems>(inputs->getParInt(ActivationName));
+}
+
 // Data Collection
 int Parameters::evalAddSample(const TD::OP_Inputs* inputs)
 {
@@ -77,6 +82,36 @@ double Parameters::evalLoss(const TD::OP_Inputs* inputs)
     return inputs->getParDouble(LossName);
 }
 
+PruneModeMenuItems Parameters::evalPruneMode(const TD::OP_Inputs* inputs)
+{
+    return static_cast<PruneModeMenuItems>(inputs->getParInt(PruneModeName));
+}
+
+double Parameters::evalPruneSparsity(const TD::OP_Inputs* inputs)
+{
+    return inputs->getParDouble(PruneSparsityName);
+}
+
+int Parameters::evalFinetuneEpochs(const TD::OP_Inputs* inputs)
+{
+    return inputs->getParInt(FinetuneEpochsName);
+}
+
+int Parameters::evalStudentLayers(const TD::OP_Inputs* inputs)
+{
+    return inputs->getParInt(StudentLayersName);
+}
+
+int Parameters::evalStudentUnits(const TD::OP_Inputs* inputs)
+{
+    return inputs->getParInt(StudentUnitsName);
+}
+
+int Parameters::evalDistillSamples(const TD::OP_Inputs* inputs)
+{
+    return inputs->getParInt(DistillSamplesName);
+}
+
 // Runtime/Smoothing
 bool Parameters::evalSmoothEnable(const TD::OP_Inputs* inputs)
 {
@@ -93,6 +128,117 @@ double Parameters::evalBeta(const TD::OP_Inputs* inputs)
     return inputs->getParDouble(BetaName);
 }
 
+FilterTypeMenuItems Parameters::evalFilterType(const TD::OP_Inputs* inputs)
+{
+    return static_cast<FilterTypeMenuItems>(inputs->getParInt(FilterTypeName));
+}
+
+double Parameters::evalSlewRate(const TD::OP_Inputs* inputs)
+{
+    return inputs->getParDouble(SlewRateName);
+}
+
+double Parameters::evalLagUp(const TD::OP_Inputs* inputs)
+{
+    return inputs->getParDouble(LagUpName);
+}
+
+double Parameters::evalLagDown(const TD::OP_Inputs* inputs)
+{
+    return inputs->getParDouble(LagDownName);
+}
+
+double Parameters::evalProcessNoise(const TD::OP_Inputs* inputs)
+{
+    return inputs->getParDouble(ProcessNoiseName);
+}
+
+double Parameters::evalMeasurementNoise(const TD::OP_Inputs* inputs)
+{
+    return inputs->getParDouble(MeasurementNoiseName);
+}
+
+bool Parameters::evalUpsample(const TD::OP_Inputs* inputs)
+{
+    return inputs->getParInt(UpsampleName) ? true : false;
+}
+
+double Parameters::evalUpsampleRate(const TD::OP_Inputs* inputs)
+{
+    return inputs->getParDouble(UpsampleRateName);
+}
+
+InterpolationMenuItems Parameters::evalInterpolation(const TD::OP_Inputs* inputs)
+{
+    return static_cast<InterpolationMenuItems>(inputs->getParInt(InterpolationName));
+}
+
+InstanceModeMenuItems Parameters::evalInstanceMode(const TD::OP_Inputs* inputs)
+{
+    return static_cast<InstanceModeMenuItems>(inputs->getParInt(InstanceModeName));
+}
+
+PrecisionMenuItems Parameters::evalPrecision(const TD::OP_Inputs* inputs)
+{
+    return static_cast<PrecisionMenuItems>(inputs->getParInt(PrecisionName));
+}
+
+bool Parameters::evalJacobian(const TD::OP_Inputs* inputs)
+{
+    return inputs->getParInt(JacobianName) ? true : false;
+}
+
+bool Parameters::evalWatchdog(const TD::OP_Inputs* inputs)
+{
+    return inputs->getParInt(WatchdogName) ? true : false;
+}
+
+double Parameters::evalCookBudget(const TD::OP_Inputs* inputs)
+{
+    return inputs->getParDouble(CookBudgetName);
+}
+
+BudgetFallbackMenuItems Parameters::evalBudgetFallback(const TD::OP_Inputs* inputs)
+{
+    return static_cast<BudgetFallbackMenuItems>(inputs->getParInt(BudgetFallbackName));
+}
+
+RunSourceMenuItems Parameters::evalRunSource(const TD::OP_Inputs* inputs)
+{
+    return static_cast<RunSourceMenuItems>(inputs->getParInt(RunSourceName));
+}
+
+int Parameters::evalLutResolution(const TD::OP_Inputs* inputs)
+{
+    return inputs->getParInt(LutResolutionName);
+}
+
+int Parameters::evalBakeLut(const TD::OP_Inputs* inputs)
+{
+    return inputs->getParInt(BakeLutName);
+}
+
+// Model Bank
+int Parameters::evalBankIndex(const TD::OP_Inputs* inputs)
+{
+    return inputs->getParInt(BankIndexName);
+}
+
+MorphModeMenuItems Parameters::evalMorphMode(const TD::OP_Inputs* inputs)
+{
+    return static_cast<MorphModeMenuItems>(inputs->getParInt(MorphModeName));
+}
+
+int Parameters::evalMorphTarget(const TD::OP_Inputs* inputs)
+{
+    return inputs->getParInt(MorphTargetName);
+}
+
+double Parameters::evalMorphAmount(const TD::OP_Inputs* inputs)
+{
+    return inputs->getParDouble(MorphAmountName);
+}
+
 // Model File
 std::string Parameters::evalModelFile(const TD::OP_Inputs* inputs)
 {
@@ -109,6 +255,26 @@ int Parameters::evalLoadModel(const TD::OP_Inputs* inputs)
     return inputs->getParInt(LoadModelName);
 }
 
+bool Parameters::evalHotReload(const TD::OP_Inputs* inputs)
+{
+    return inputs->getParInt(HotReloadName) ? true : false;
+}
+
+std::string Parameters::evalBankFile(const TD::OP_Inputs* inputs)
+{
+    return inputs->getParString(BankFileName);
+}
+
+std::string Parameters::evalDatasetFile(const TD::OP_Inputs* inputs)
+{
+    return inputs->getParString(DatasetFileName);
+}
+
+std::string Parameters::evalBundleFile(const TD::OP_Inputs* inputs)
+{
+    return inputs->getParString(BundleFileName);
+}
+
 // Dynamic channel names (placeholder for now)
 std::string Parameters::evalInChannelName(const TD::OP_Inputs* inputs, int index)
 {
@@ -179,6 +345,18 @@ void Parameters::setup(TD::OP_ParameterManager* manager)
         assert(res == TD::OP_ParAppendResult::Success);
     }
 
+    {
+        TD::OP_StringParameter p;
+        p.name = ActivationName;
+        p.label = ActivationLabel;
+        p.page = "Model";
+        p.defaultValue = "Exact";
+        std::array<const char*, 2> Names = {"Exact", "Fast"};
+        std::array<const char*, 2> Labels = {"Exact (libm)", "Fast (Rational)"};
+        TD::OP_ParAppendResult res = manager->appendMenu(p, Names.size(), Names.data(), Labels.data());
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
     // Data Collection Page
     {
         TD::OP_NumericParameter p;
@@ -286,6 +464,106 @@ void Parameters::setup(TD::OP_ParameterManager* manager)
         assert(res == TD::OP_ParAppendResult::Success);
     }
 
+    {
+        TD::OP_StringParameter p;
+        p.name = PruneModeName;
+        p.label = PruneModeLabel;
+        p.page = "Training";
+        p.defaultValue = "Weights";
+        std::array<const char*, 2> Names = {"Weights", "Neurons"};
+        std::array<const char*, 2> Labels = {"Weights (Sparse)", "Neurons (Compacted)"};
+        TD::OP_ParAppendResult res = manager->appendMenu(p, Names.size(), Names.data(), Labels.data());
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = PruneSparsityName;
+        p.label = PruneSparsityLabel;
+        p.page = "Training";
+        p.defaultValues[0] = 0.5;
+        p.minValues[0] = 0.0;
+        p.maxValues[0] = 0.95;
+        p.clampMins[0] = true;
+        p.clampMaxes[0] = true;
+        TD::OP_ParAppendResult res = manager->appendFloat(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = FinetuneEpochsName;
+        p.label = FinetuneEpochsLabel;
+        p.page = "Training";
+        p.defaultValues[0] = 50;
+        p.minValues[0] = 0;
+        p.maxValues[0] = 1000;
+        p.clampMins[0] = true;
+        p.clampMaxes[0] = false;
+        TD::OP_ParAppendResult res = manager->appendInt(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = PruneName;
+        p.label = PruneLabel;
+        p.page = "Training";
+        TD::OP_ParAppendResult res = manager->appendPulse(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = StudentLayersName;
+        p.label = StudentLayersLabel;
+        p.page = "Training";
+        p.defaultValues[0] = 1;
+        p.minValues[0] = 1;
+        p.maxValues[0] = 5;
+        p.clampMins[0] = true;
+        p.clampMaxes[0] = true;
+        TD::OP_ParAppendResult res = manager->appendInt(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = StudentUnitsName;
+        p.label = StudentUnitsLabel;
+        p.page = "Training";
+        p.defaultValues[0] = 16;
+        p.minValues[0] = 4;
+        p.maxValues[0] = 512;
+        p.clampMins[0] = true;
+        p.clampMaxes[0] = false;
+        TD::OP_ParAppendResult res = manager->appendInt(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = DistillSamplesName;
+        p.label = DistillSamplesLabel;
+        p.page = "Training";
+        p.defaultValues[0] = 4096;
+        p.minValues[0] = 256;
+        p.maxValues[0] = 65536;
+        p.clampMins[0] = true;
+        p.clampMaxes[0] = false;
+        TD::OP_ParAppendResult res = manager->appendInt(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = DistillName;
+        p.label = DistillLabel;
+        p.page = "Training";
+        TD::OP_ParAppendResult res = manager->appendPulse(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
     // Runtime Page
     {
         TD::OP_NumericParameter p;
@@ -325,6 +603,311 @@ void Parameters::setup(TD::OP_ParameterManager* manager)
         assert(res == TD::OP_ParAppendResult::Success);
     }
 
+    {
+        TD::OP_StringParameter p;
+        p.name = FilterTypeName;
+        p.label = FilterTypeLabel;
+        p.page = "Runtime";
+        p.defaultValue = "Oneeuro";
+        std::array<const char*, 4> Names = {"Oneeuro", "Slew", "Lag", "Kalman"};
+        std::array<const char*, 4> Labels = {"OneEuro", "Slew Limit", "Lag", "Kalman"};
+        TD::OP_ParAppendResult res = manager->appendMenu(p, Names.size(), Names.data(), Labels.data());
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = SlewRateName;
+        p.label = SlewRateLabel;
+        p.page = "Runtime";
+        p.defaultValues[0] = 1.0;
+        p.minValues[0] = 0.0;
+        p.maxValues[0] = 10.0;
+        p.clampMins[0] = true;
+        p.clampMaxes[0] = false;
+        TD::OP_ParAppendResult res = manager->appendFloat(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = LagUpName;
+        p.label = LagUpLabel;
+        p.page = "Runtime";
+        p.defaultValues[0] = 0.1;
+        p.minValues[0] = 0.0;
+        p.maxValues[0] = 5.0;
+        p.clampMins[0] = true;
+        p.clampMaxes[0] = false;
+        TD::OP_ParAppendResult res = manager->appendFloat(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = LagDownName;
+        p.label = LagDownLabel;
+        p.page = "Runtime";
+        p.defaultValues[0] = 0.1;
+        p.minValues[0] = 0.0;
+        p.maxValues[0] = 5.0;
+        p.clampMins[0] = true;
+        p.clampMaxes[0] = false;
+        TD::OP_ParAppendResult res = manager->appendFloat(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = ProcessNoiseName;
+        p.label = ProcessNoiseLabel;
+        p.page = "Runtime";
+        p.defaultValues[0] = 1.0;
+        p.minValues[0] = 0.0;
+        p.maxValues[0] = 100.0;
+        p.clampMins[0] = true;
+        p.clampMaxes[0] = false;
+        TD::OP_ParAppendResult res = manager->appendFloat(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = MeasurementNoiseName;
+        p.label = MeasurementNoiseLabel;
+        p.page = "Runtime";
+        p.defaultValues[0] = 0.01;
+        p.minValues[0] = 0.0;
+        p.maxValues[0] = 1.0;
+        p.clampMins[0] = true;
+        p.clampMaxes[0] = false;
+        TD::OP_ParAppendResult res = manager->appendFloat(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = UpsampleName;
+        p.label = UpsampleLabel;
+        p.page = "Runtime";
+        p.defaultValues[0] = false;
+        TD::OP_ParAppendResult res = manager->appendToggle(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = UpsampleRateName;
+        p.label = UpsampleRateLabel;
+        p.page = "Runtime";
+        p.defaultValues[0] = 48000.0;
+        p.minValues[0] = 1.0;
+        p.maxValues[0] = 192000.0;
+        p.clampMins[0] = true;
+        p.clampMaxes[0] = true;
+        TD::OP_ParAppendResult res = manager->appendFloat(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_StringParameter p;
+        p.name = InterpolationName;
+        p.label = InterpolationLabel;
+        p.page = "Runtime";
+        p.defaultValue = "Cubic";
+        std::array<const char*, 2> Names = {"Linear", "Cubic"};
+        std::array<const char*, 2> Labels = {"Linear", "Cubic"};
+        TD::OP_ParAppendResult res = manager->appendMenu(p, Names.size(), Names.data(), Labels.data());
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_StringParameter p;
+        p.name = InstanceModeName;
+        p.label = InstanceModeLabel;
+        p.page = "Runtime";
+        p.defaultValue = "Off";
+        std::array<const char*, 3> Names = {"Off", "Channelgroups", "Samples"};
+        std::array<const char*, 3> Labels = {"Off", "Channel Groups", "Samples"};
+        TD::OP_ParAppendResult res = manager->appendMenu(p, Names.size(), Names.data(), Labels.data());
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_StringParameter p;
+        p.name = PrecisionName;
+        p.label = PrecisionLabel;
+        p.page = "Runtime";
+        p.defaultValue = "Float32";
+        std::array<const char*, 2> Names = {"Float32", "Int8"};
+        std::array<const char*, 2> Labels = {"Float32", "Int8 (Quantized)"};
+        TD::OP_ParAppendResult res = manager->appendMenu(p, Names.size(), Names.data(), Labels.data());
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = JacobianName;
+        p.label = JacobianLabel;
+        p.page = "Runtime";
+        p.defaultValues[0] = false;
+        TD::OP_ParAppendResult res = manager->appendToggle(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = WatchdogName;
+        p.label = WatchdogLabel;
+        p.page = "Runtime";
+        p.defaultValues[0] = false;
+        TD::OP_ParAppendResult res = manager->appendToggle(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = CookBudgetName;
+        p.label = CookBudgetLabel;
+        p.page = "Runtime";
+        p.defaultValues[0] = 1000.0;
+        p.minValues[0] = 10.0;
+        p.maxValues[0] = 16667.0;
+        p.clampMins[0] = true;
+        p.clampMaxes[0] = false;
+        TD::OP_ParAppendResult res = manager->appendFloat(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_StringParameter p;
+        p.name = BudgetFallbackName;
+        p.label = BudgetFallbackLabel;
+        p.page = "Runtime";
+        p.defaultValue = "Auto";
+        std::array<const char*, 4> Names = {"Auto", "Lut", "Hold", "Int8"};
+        std::array<const char*, 4> Labels = {"Auto", "Baked LUT", "Hold Last Output", "Int8"};
+        TD::OP_ParAppendResult res = manager->appendMenu(p, Names.size(), Names.data(), Labels.data());
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_StringParameter p;
+        p.name = RunSourceName;
+        p.label = RunSourceLabel;
+        p.page = "Runtime";
+        p.defaultValue = "Network";
+        std::array<const char*, 2> Names = {"Network", "Lut"};
+        std::array<const char*, 2> Labels = {"Network", "Baked LUT"};
+        TD::OP_ParAppendResult res = manager->appendMenu(p, Names.size(), Names.data(), Labels.data());
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = LutResolutionName;
+        p.label = LutResolutionLabel;
+        p.page = "Runtime";
+        p.defaultValues[0] = 33;
+        p.minValues[0] = 2;
+        p.maxValues[0] = 257;
+        p.clampMins[0] = true;
+        p.clampMaxes[0] = false;
+        TD::OP_ParAppendResult res = manager->appendInt(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = BakeLutName;
+        p.label = BakeLutLabel;
+        p.page = "Runtime";
+        TD::OP_ParAppendResult res = manager->appendPulse(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    // Model Bank Page
+    {
+        TD::OP_NumericParameter p;
+        p.name = BankIndexName;
+        p.label = BankIndexLabel;
+        p.page = "Bank";
+        p.defaultValues[0] = 0;
+        p.minValues[0] = 0;
+        p.maxValues[0] = 63;
+        p.clampMins[0] = true;
+        p.clampMaxes[0] = true;
+        TD::OP_ParAppendResult res = manager->appendInt(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_StringParameter p;
+        p.name = BankIndexChopName;
+        p.label = BankIndexChopLabel;
+        p.page = "Bank";
+        TD::OP_ParAppendResult res = manager->appendCHOP(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = StoreInBankName;
+        p.label = StoreInBankLabel;
+        p.page = "Bank";
+        TD::OP_ParAppendResult res = manager->appendPulse(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = ClearBankName;
+        p.label = ClearBankLabel;
+        p.page = "Bank";
+        TD::OP_ParAppendResult res = manager->appendPulse(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_StringParameter p;
+        p.name = MorphModeName;
+        p.label = MorphModeLabel;
+        p.page = "Bank";
+        p.defaultValue = "Off";
+        std::array<const char*, 3> Names = {"Off", "Weights", "Outputs"};
+        std::array<const char*, 3> Labels = {"Off", "Weight Space", "Output Space"};
+        TD::OP_ParAppendResult res = manager->appendMenu(p, Names.size(), Names.data(), Labels.data());
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = MorphTargetName;
+        p.label = MorphTargetLabel;
+        p.page = "Bank";
+        p.defaultValues[0] = 1;
+        p.minValues[0] = 0;
+        p.maxValues[0] = 63;
+        p.clampMins[0] = true;
+        p.clampMaxes[0] = true;
+        TD::OP_ParAppendResult res = manager->appendInt(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = MorphAmountName;
+        p.label = MorphAmountLabel;
+        p.page = "Bank";
+        p.defaultValues[0] = 0.0;
+        p.minValues[0] = 0.0;
+        p.maxValues[0] = 1.0;
+        p.clampMins[0] = true;
+        p.clampMaxes[0] = true;
+        TD::OP_ParAppendResult res = manager->appendFloat(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
     // Model File Page
     {
         TD::OP_StringParameter p;
@@ -353,6 +936,100 @@ void Parameters::setup(TD::OP_ParameterManager* manager)
         TD::OP_ParAppendResult res = manager->appendPulse(p);
         assert(res == TD::OP_ParAppendResult::Success);
     }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = HotReloadName;
+        p.label = HotReloadLabel;
+        p.page = "File";
+        p.defaultValues[0] = false;
+        TD::OP_ParAppendResult res = manager->appendToggle(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_StringParameter p;
+        p.name = BankFileName;
+        p.label = BankFileLabel;
+        p.page = "File";
+        p.defaultValue = "";
+        TD::OP_ParAppendResult res = manager->appendFile(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = SaveBankName;
+        p.label = SaveBankLabel;
+        p.page = "File";
+        TD::OP_ParAppendResult res = manager->appendPulse(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = LoadBankName;
+        p.label = LoadBankLabel;
+        p.page = "File";
+        TD::OP_ParAppendResult res = manager->appendPulse(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_StringParameter p;
+        p.name = DatasetFileName;
+        p.label = DatasetFileLabel;
+        p.page = "File";
+        p.defaultValue = "";
+        TD::OP_ParAppendResult res = manager->appendFile(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = SaveDatasetName;
+        p.label = SaveDatasetLabel;
+        p.page = "File";
+        TD::OP_ParAppendResult res = manager->appendPulse(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = LoadDatasetName;
+        p.label = LoadDatasetLabel;
+        p.page = "File";
+        TD::OP_ParAppendResult res = manager->appendPulse(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_StringParameter p;
+        p.name = BundleFileName;
+        p.label = BundleFileLabel;
+        p.page = "File";
+        p.defaultValue = "";
+        TD::OP_ParAppendResult res = manager->appendFile(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = SaveBundleName;
+        p.label = SaveBundleLabel;
+        p.page = "File";
+        TD::OP_ParAppendResult res = manager->appendPulse(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
+
+    {
+        TD::OP_NumericParameter p;
+        p.name = LoadBundleName;
+        p.label = LoadBundleLabel;
+        p.page = "File";
+        TD::OP_ParAppendResult res = manager->appendPulse(p);
+        assert(res == TD::OP_ParAppendResult::Success);
+    }
 }
 
 #pragma endregion
\ No newline at end of file
@@ -28,6 +28,9 @@ constexpr static char OutDimLabel[] = "Output Dimensions";
 constexpr static char NormalizeName[] = "Normalize";
 constexpr static char NormalizeLabel[] = "Normalize Data";
 
+constexpr static char ActivationName[] = "Activation";
+constexpr static char ActivationLabel[] = "Activation Precision";
+
 // Data Collection Parameters
 constexpr static char AddSampleName[] = "Addsample";
 constexpr static char AddSampleLabel[] = "Add Sample";
@@ -57,6 +60,30 @@ constexpr static char HiddenUnitsLabel[] = "Hidden Units";
 constexpr static char LossName[] = "Loss";
 constexpr static char LossLabel[] = "Training Loss";
 
+constexpr static char PruneModeName[] = "Prunemode";
+constexpr static char PruneModeLabel[] = "Prune Mode";
+
+constexpr static char PruneSparsityName[] = "Prunesparsity";
+constexpr static char PruneSparsityLabel[] = "Prune Sparsity";
+
+constexpr static char FinetuneEpochsName[] = "Finetuneepochs";
+constexpr static char FinetuneEpochsLabel[] = "Fine-tune Epochs";
+
+constexpr static char PruneName[] = "Prune";
+constexpr static char PruneLabel[] = "Prune Model";
+
+constexpr static char StudentLayersName[] = "Studentlayers";
+constexpr static char StudentLayersLabel[] = "Student Hidden Layers";
+
+constexpr static char StudentUnitsName[] = "Studentunits";
+constexpr static char StudentUnitsLabel[] = "Student Hidden Units";
+
+constexpr static char DistillSamplesName[] = "Distillsamples";
+constexpr static char DistillSamplesLabel[] = "Distill Samples";
+
+constexpr static char DistillName[] = "Distill";
+constexpr static char DistillLabel[] = "Distill Model";
+
 // Runtime/Smoothing Parameters
 constexpr static char SmoothEnableName[] = "Smoothenable";
 constexpr static char SmoothEnableLabel[] = "Enable Smoothing";
@@ -67,6 +94,82 @@ constexpr static char MinCutoffLabel[] = "Min Cutoff Frequency";
 constexpr static char BetaName[] = "Beta";
 constexpr static char BetaLabel[] = "Speed Coefficient";
 
+constexpr static char FilterTypeName[] = "Filtertype";
+constexpr static char FilterTypeLabel[] = "Filter Type";
+
+constexpr static char SlewRateName[] = "Slewrate";
+constexpr static char SlewRateLabel[] = "Slew Rate (units/s)";
+
+constexpr static char LagUpName[] = "Lagup";
+constexpr static char LagUpLabel[] = "Lag Up (s)";
+
+constexpr static char LagDownName[] = "Lagdown";
+constexpr static char LagDownLabel[] = "Lag Down (s)";
+
+constexpr static char ProcessNoiseName[] = "Processnoise";
+constexpr static char ProcessNoiseLabel[] = "Kalman Process Noise";
+
+constexpr static char MeasurementNoiseName[] = "Measurementnoise";
+constexpr static char MeasurementNoiseLabel[] = "Kalman Measurement Noise";
+
+constexpr static char UpsampleName[] = "Upsample";
+constexpr static char UpsampleLabel[] = "Upsample to Audio Rate";
+
+constexpr static char UpsampleRateName[] = "Upsamplerate";
+constexpr static char UpsampleRateLabel[] = "Upsample Rate (Hz)";
+
+constexpr static char InterpolationName[] = "Interpolation";
+constexpr static char InterpolationLabel[] = "Interpolation";
+
+constexpr static char InstanceModeName[] = "Instancemode";
+constexpr static char InstanceModeLabel[] = "Instance Mode";
+
+constexpr static char PrecisionName[] = "Precision";
+constexpr static char PrecisionLabel[] = "Inference Precision";
+
+constexpr static char JacobianName[] = "Jacobian";
+constexpr static char JacobianLabel[] = "Output Jacobian";
+
+constexpr static char WatchdogName[] = "Watchdog";
+constexpr static char WatchdogLabel[] = "Cook Budget Watchdog";
+
+constexpr static char CookBudgetName[] = "Cookbudget";
+constexpr static char CookBudgetLabel[] = "Cook Budget (us)";
+
+constexpr static char BudgetFallbackName[] = "Budgetfallback";
+constexpr static char BudgetFallbackLabel[] = "Budget Fallback";
+
+constexpr static char RunSourceName[] = "Runsource";
+constexpr static char RunSourceLabel[] = "Run Source";
+
+constexpr static char LutResolutionName[] = "Lutresolution";
+constexpr static char LutResolutionLabel[] = "LUT Resolution";
+
+constexpr static char BakeLutName[] = "Bakelut";
+constexpr static char BakeLutLabel[] = "Bake LUT";
+
+// Model Bank Parameters
+constexpr static char BankIndexName[] = "Bankindex";
+constexpr static char BankIndexLabel[] = "Bank Index";
+
+constexpr static char BankIndexChopName[] = "Bankindexchop";
+constexpr static char BankIndexChopLabel[] = "Bank Index CHOP";
+
+constexpr static char StoreInBankName[] = "Storeinbank";
+constexpr static char StoreInBankLabel[] = "Store In Bank";
+
+constexpr static char ClearBankName[] = "Clearbank";
+constexpr static char ClearBankLabel[] = "Clear Bank";
+
+constexpr static char MorphModeName[] = "Morphmode";
+constexpr static char MorphModeLabel[] = "Morph Mode";
+
+constexpr static char MorphTargetName[] = "Morphtarget";
+constexpr static char MorphTargetLabel[] = "Morph Target Slot";
+
+constexpr static char MorphAmountName[] = "Morphamount";
+constexpr static char MorphAmountLabel[] = "Morph Amount";
+
 // Model File Parameters
 constexpr static char ModelFileName[] = "Modelfile";
 constexpr static char ModelFileLabel[] = "Model File Path";
@@ -77,6 +180,36 @@ constexpr static char SaveModelLabel[] = "Save Model";
 constexpr static char LoadModelName[] = "Loadmodel";
 constexpr static char LoadModelLabel[] = "Load Model";
 
+constexpr static char HotReloadName[] = "Hotreload";
+constexpr static char HotReloadLabel[] = "Reload Model On Change";
+
+constexpr static char BankFileName[] = "Bankfile";
+constexpr static char BankFileLabel[] = "Bank File Path";
+
+constexpr static char SaveBankName[] = "Savebank";
+constexpr static char SaveBankLabel[] = "Save Bank";
+
+constexpr static char LoadBankName[] = "Loadbank";
+constexpr static char LoadBankLabel[] = "Load Bank";
+
+constexpr static char DatasetFileName[] = "Datasetfile";
+constexpr static char DatasetFileLabel[] = "Dataset File Path";
+
+constexpr static char SaveDatasetName[] = "Savedataset";
+constexpr static char SaveDatasetLabel[] = "Save Dataset";
+
+constexpr static char LoadDatasetName[] = "Loaddataset";
+constexpr static char LoadDatasetLabel[] = "Load Dataset";
+
+constexpr static char BundleFileName[] = "Bundlefile";
+constexpr static char BundleFileLabel[] = "Project Bundle Path";
+
+constexpr static char SaveBundleName[] = "Savebundle";
+constexpr static char SaveBundleLabel[] = "Save Bundle";
+
+constexpr static char LoadBundleName[] = "Loadbundle";
+constexpr static char LoadBundleLabel[] = "Load Bundle";
+
 #pragma endregion
 
 #pragma region Menus
@@ -88,6 +221,68 @@ enum class ModeMenuItems
     Run = 2
 };
 
+enum class ActivationMenuItems
+{
+    Exact = 0,
+    Fast = 1
+};
+
+enum class PruneModeMenuItems
+{
+    Weights = 0,
+    Neurons = 1
+};
+
+// Same order as OutputFilterType
+enum class FilterTypeMenuItems
+{
+    Oneeuro = 0,
+    Slew = 1,
+    Lag = 2,
+    Kalman = 3
+};
+
+// Same order as UpsampleInterpolation
+enum class InterpolationMenuItems
+{
+    Linear = 0,
+    Cubic = 1
+};
+
+enum class InstanceModeMenuItems
+{
+    Off = 0,
+    Channelgroups = 1,
+    Samples = 2
+};
+
+enum class PrecisionMenuItems
+{
+    Float32 = 0,
+    Int8 = 1
+};
+
+enum class RunSourceMenuItems
+{
+    Network = 0,
+    Lut = 1
+};
+
+enum class BudgetFallbackMenuItems
+{
+    Auto = 0,
+    Lut = 1,
+    Hold = 2,
+    Int8 = 3
+};
+
+enum class MorphModeMenuItems
+{
+    Off = 0,
+    Weights = 1,
+    Outputs = 2
+};
+
 #pragma endregion
 
 #pragma region Parameters
@@ -102,6 +297,7 @@ public:
     static int evalInDim(const TD::OP_Inputs* inputs);
     static int evalOutDim(const TD::OP_Inputs* inputs);
     static bool evalNormalize(const TD::OP_Inputs* inputs);
+    static ActivationMenuItems evalActivation(const TD::OP_Inputs* inputs);
 
     // Data Collection  
     static int evalAddSample(const TD::OP_Inputs* inputs);
@@ -115,16 +311,50 @@ public:
     static int evalHiddenLayers(const TD::OP_Inputs* inputs);
     static int evalHiddenUnits(const TD::OP_Inputs* inputs);
     static double evalLoss(const TD::OP_Inputs* inputs);
+    static PruneModeMenuItems evalPruneMode(const TD::OP_Inputs* inputs);
+    static double evalPruneSparsity(const TD::OP_Inputs* inputs);
+    static int evalFinetuneEpochs(const TD::OP_Inputs* inputs);
+    static int evalStudentLayers(const TD::OP_Inputs* inputs);
+    static int evalStudentUnits(const TD::OP_Inputs* inputs);
+    static int evalDistillSamples(const TD::OP_Inputs* inputs);
 
     // Runtime/Smoothing
     static bool evalSmoothEnable(const TD::OP_Inputs* inputs);
     static double evalMinCutoff(const TD::OP_Inputs* inputs);
     static double evalBeta(const TD::OP_Inputs* inputs);
+    static FilterTypeMenuItems evalFilterType(const TD::OP_Inputs* inputs);
+    static double evalSlewRate(const TD::OP_Inputs* inputs);
+    static double evalLagUp(const TD::OP_Inputs* inputs);
+    static double evalLagDown(const TD::OP_Inputs* inputs);
+    static double evalProcessNoise(const TD::OP_Inputs* inputs);
+    static double evalMeasurementNoise(const TD::OP_Inputs* inputs);
+    static bool evalUpsample(const TD::OP_Inputs* inputs);
+    static double evalUpsampleRate(const TD::OP_Inputs* inputs);
+    static InterpolationMenuItems evalInterpolation(const TD::OP_Inputs* inputs);
+    static InstanceModeMenuItems evalInstanceMode(const TD::OP_Inputs* inputs);
+    static PrecisionMenuItems evalPrecision(const TD::OP_Inputs* inputs);
+    static bool evalJacobian(const TD::OP_Inputs* inputs);
+    static bool evalWatchdog(const TD::OP_Inputs* inputs);
+    static double evalCookBudget(const TD::OP_Inputs* inputs);
+    static BudgetFallbackMenuItems evalBudgetFallback(const TD::OP_Inputs* inputs);
+    static RunSourceMenuItems evalRunSource(const TD::OP_Inputs* inputs);
+    static int evalLutResolution(const TD::OP_Inputs* inputs);
+    static int evalBakeLut(const TD::OP_Inputs* inputs);
+
+    // Model Bank
+    static int evalBankIndex(const TD::OP_Inputs* inputs);
+    static MorphModeMenuItems evalMorphMode(const TD::OP_Inputs* inputs);
+    static int evalMorphTarget(const TD::OP_Inputs* inputs);
+    static double evalMorphAmount(const TD::OP_Inputs* inputs);
 
     // Model File
     static std::string evalModelFile(const TD::OP_Inputs* inputs);
     static int evalSaveModel(const TD::OP_Inputs* inputs);
     static int evalLoadModel(const TD::OP_Inputs* inputs);
+    static bool evalHotReload(const TD::OP_Inputs* inputs);
+    static std::string evalBankFile(const TD::OP_Inputs* inputs);
+    static std::string evalDatasetFile(const TD::OP_Inputs* inputs);
+    static std::string evalBundleFile(const TD::OP_Inputs* inputs);
     
     // Dynamic channel name getters (will be implemented later)
     static std::string evalInChannelName(const TD::OP_Inputs* inputs, int index);
@@ -0,0 +1,418 @@
+/* TD-NeuroMap Project Bundle Implementation
+ *
+ * Layout (native little-endian):
+ *   0   char[4]  magic "NMPB"
+ *   4   uint32   version
+ *   8   uint64   checksum of bytes [16, end of section table)   (ModelFile::checksum)
+ *   16  uint32   sectionCount
+ *   20  uint32   reserved
+ *   24  per section, 32 bytes:
+ *         uint32 type, uint32 reserved
+ *         uint64 offset, size
+ *         uint64 hash
+ *
+ * Section payloads:
+ *   Settings       int32 inputDim, outputDim, hiddenLayers, hiddenUnits, epochs
+ *                  float learnRate
+ *                  int32 normalize, activation
+ *   Normalization  int32 inputDim, outputDim
+ *                  float inputMin[inputDim], inputMax[inputDim]
+ *                  float outputMin[outputDim], outputMax[outputDim]
+ *   Model          model file image (current version)
+ *   Dataset        dataset file image
+ *
+ * Settings and normalization are small and follow the table at 64-byte
+ * offsets. Model and dataset start on MappedFile::ViewAlignment offsets.
+ * Their hash is the checksum stored in the image, which their parsers
+ * verify, so every byte is hashed once per load; the small sections are
+ * hashed with ModelFile::checksum.
+ */
+
+#include "ProjectBundle.h"
+#include "ModelFile.h"
+#include "MappedFile.h"
+#include "AlignedBuffer.h"
+#include <cstring>
+
+namespace
+{
+    const char Magic[4] = { 'N', 'M', 'P', 'B' };
+    const uint32_t Version = 1;
+    const size_t ChecksumOffset = 8;
+    const size_t ChecksummedOffset = 16;
+    const size_t HeaderSize = 24;
+    const size_t EntrySize = 32;
+    const size_t SettingsSize = 32;
+    const uint32_t MaxSections = 16;
+    const int MaxDim = 4096;
+
+    enum class SectionType : uint32_t
+    {
+        Settings = 1,
+        Normalization = 2,
+        Model = 3,
+        Dataset = 4
+    };
+
+    struct Section
+    {
+        SectionType type;
+        uint64_t offset;
+        uint64_t size;
+        uint64_t hash;
+    };
+
+    size_t alignOffset(size_t offset, size_t alignment)
+    {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+
+    template <typename T>
+    void writeAt(std::vector<char>& out, size_t offset, const T& value)
+    {
+        std::memcpy(out.data() + offset, &value, sizeof(T));
+    }
+
+    template <typename T>
+    T readAt(const char* data, size_t offset)
+    {
+        T value;
+        std::memcpy(&value, data + offset, sizeof(T));
+        return value;
+    }
+
+    void writeFloats(std::vector<char>& out, size_t& offset, const std::vector<float>& values)
+    {
+        std::memcpy(out.data() + offset, values.data(), values.size() * sizeof(float));
+        offset += values.size() * sizeof(float);
+    }
+
+    void readFloats(const char* data, size_t& offset, int count, std::vector<float>& values)
+    {
+        values.resize(count);
+        std::memcpy(values.data(), data + offset, count * sizeof(float));
+        offset += count * sizeof(float);
+    }
+
+    void serializeSettings(const ProjectBundle::Settings& settings, std::vector<char>& out)
+    {
+        out.assign(SettingsSize, 0);
+        writeAt(out, 0, static_cast<int32_t>(settings.inputDim));
+        writeAt(out, 4, static_cast<int32_t>(settings.outputDim));
+        writeAt(out, 8, static_cast<int32_t>(settings.hiddenLayers));
+        writeAt(out, 12, static_cast<int32_t>(settings.hiddenUnits));
+        writeAt(out, 16, static_cast<int32_t>(settings.epochs));
+        writeAt(out, 20, settings.learnRate);
+        writeAt(out, 24, static_cast<int32_t>(settings.normalize ? 1 : 0));
+        writeAt(out, 28, static_cast<int32_t>(settings.activation));
+    }
+
+    bool parseSettings(const char* data, size_t size, ProjectBundle::Settings& settings)
+    {
+        if (size != SettingsSize)
+            return false;
+        settings.inputDim = readAt<int32_t>(data, 0);
+        settings.outputDim = readAt<int32_t>(data, 4);
+        settings.hiddenLayers = readAt<int32_t>(data, 8);
+        settings.hiddenUnits = readAt<int32_t>(data, 12);
+        settings.epochs = readAt<int32_t>(data, 16);
+        settings.learnRate = readAt<float>(data, 20);
+        settings.normalize = readAt<int32_t>(data, 24) != 0;
+        settings.activation = readAt<int32_t>(data, 28);
+        return settings.inputDim >= 1 && settings.outputDim >= 1 &&
+               settings.inputDim <= MaxDim && settings.outputDim <= MaxDim;
+    }
+
+    void serializeNormalization(const NormalizationBounds& bounds, std::vector<char>& out)
+    {
+        const size_t numFloats = 2 * (bounds.inputMin.size() + bounds.outputMin.size());
+        out.assign(8 + numFloats * sizeof(float), 0);
+        writeAt(out, 0, static_cast<int32_t>(bounds.inputMin.size()));
+        writeAt(out, 4, static_cast<int32_t>(bounds.outputMin.size()));
+        size_t offset = 8;
+        writeFloats(out, offset, bounds.inputMin);
+        writeFloats(out, offset, bounds.inputMax);
+        writeFloats(out, offset, bounds.outputMin);
+        writeFloats(out, offset, bounds.outputMax);
+    }
+
+    bool parseNormalization(const char* data, size_t size, NormalizationBounds& bounds)
+    {
+        if (size < 8)
+            return false;
+        const int32_t inputDim = readAt<int32_t>(data, 0);
+        const int32_t outputDim = readAt<int32_t>(data, 4);
+        if (inputDim < 1 || outputDim < 1 || inputDim > MaxDim || outputDim > MaxDim ||
+            size != 8 + 2 * (inputDim + outputDim) * sizeof(float))
+            return false;
+        size_t offset = 8;
+        readFloats(data, offset, inputDim, bounds.inputMin);
+        readFloats(data, offset, inputDim, bounds.inputMax);
+        readFloats(data, offset, outputDim, bounds.outputMin);
+        readFloats(data, offset, outputDim, bounds.outputMax);
+        return true;
+    }
+
+    bool sameBounds(const NormalizationBounds& a, const NormalizationBounds& b)
+    {
+        return a.inputMin == b.inputMin && a.inputMax == b.inputMax &&
+               a.outputMin == b.outputMin && a.outputMax == b.outputMax;
+    }
+
+    bool readTable(const char* data, size_t size, std::vector<Section>& sections, std::string& error)
+    {
+        if (size < HeaderSize || std::memcmp(data, Magic, sizeof(Magic)) != 0)
+        {
+            error = "Not a NeuroMap project bundle";
+            return false;
+        }
+        const uint32_t version = readAt<uint32_t>(data, 4);
+        if (version != Version)
+        {
+            error = "Unsupported bundle version " + std::to_string(version);
+            return false;
+        }
+        const uint32_t count = readAt<uint32_t>(data, 16);
+        const size_t tableEnd = HeaderSize + count * EntrySize;
+        if (count > MaxSections || tableEnd > size ||
+            readAt<uint64_t>(data, ChecksumOffset) != ModelFile::checksum(data + ChecksummedOffset, tableEnd - ChecksummedOffset))
+        {
+            error = "Bundle is corrupt (section table checksum mismatch)";
+            return false;
+        }
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const size_t entry = HeaderSize + i * EntrySize;
+            Section section;
+            section.type = static_cast<SectionType>(readAt<uint32_t>(data, entry));
+            section.offset = readAt<uint64_t>(data, entry + 8);
+            section.size = readAt<uint64_t>(data, entry + 16);
+            section.hash = readAt<uint64_t>(data, entry + 24);
+            if (section.offset < tableEnd || section.offset > size || section.size > size - section.offset)
+            {
+                error = "Invalid bundle layout";
+                return false;
+            }
+            for (const Section& other : sections)
+            {
+                if (other.type == section.type)
+                {
+                    error = "Invalid bundle layout (repeated section)";
+                    return false;
+                }
+            }
+            sections.push_back(section);
+        }
+        return true;
+    }
+
+    // The sections of one bundle must describe one node: the same
+    // dimensions everywhere, and the model's own bounds equal to the
+    // normalization section
+    bool checkConsistency(const ProjectBundle::Contents& contents, const NormalizationBounds& modelNormalization,
+                          std::string& error)
+    {
+        const ProjectBundle::Settings& settings = contents.settings;
+        const NormalizationBounds& bounds = contents.normalization;
+        if (!bounds.empty() &&
+            (bounds.inputMin.size() != static_cast<size_t>(settings.inputDim) ||
+             bounds.outputMin.size() != static_cast<size_t>(settings.outputDim)))
+        {
+            error = "Bundle normalization does not match its settings";
+            return false;
+        }
+        if (contents.network)
+        {
+            const NetworkArchitecture& arch = contents.network->getArchitecture();
+            if (arch.inputDim != settings.inputDim || arch.outputDim != settings.outputDim)
+            {
+                error = "Bundle model does not match its settings";
+                return false;
+            }
+            if (!modelNormalization.empty() && !sameBounds(modelNormalization, bounds))
+            {
+                error = "Bundle model was saved with other normalization bounds";
+                return false;
+            }
+        }
+        if (!contents.inputs.empty() &&
+            (contents.inputs[0].size() != static_cast<size_t>(settings.inputDim) ||
+             contents.targets[0].size() != static_cast<size_t>(settings.outputDim)))
+        {
+            error = "Bundle dataset does not match its settings";
+            return false;
+        }
+        return true;
+    }
+}
+
+namespace ProjectBundle
+{
+
+void serialize(const Settings& settings, const NormalizationBounds& normalization,
+               const std::vector<char>& model, const std::vector<char>& dataset,
+               std::vector<char>& out)
+{
+    std::vector<char> settingsBytes, normalizationBytes;
+    serializeSettings(settings, settingsBytes);
+    if (!normalization.empty())
+    {
+        serializeNormalization(normalization, normalizationBytes);
+    }
+
+    struct Part
+    {
+        SectionType type;
+        const std::vector<char>* bytes;
+        size_t alignment;
+        uint64_t hash;
+    };
+    std::vector<Part> parts;
+    parts.push_back({ SectionType::Settings, &settingsBytes, AlignedBuffer::Alignment,
+                      ModelFile::checksum(settingsBytes.data(), settingsBytes.size()) });
+    if (!normalizationBytes.empty())
+    {
+        parts.push_back({ SectionType::Normalization, &normalizationBytes, AlignedBuffer::Alignment,
+                          ModelFile::checksum(normalizationBytes.data(), normalizationBytes.size()) });
+    }
+    if (!model.empty())
+    {
+        parts.push_back({ SectionType::Model, &model, MappedFile::ViewAlignment,
+                          ModelFile::contentHash(model.data(), model.size()) });
+    }
+    parts.push_back({ SectionType::Dataset, &dataset, MappedFile::ViewAlignment,
+                      DatasetFile::contentHash(dataset.data(), dataset.size()) });
+
+    // Lay out first, then write once into a buffer of the final size
+    const size_t tableEnd = HeaderSize + parts.size() * EntrySize;
+    std::vector<size_t> offsets;
+    size_t end = tableEnd;
+    for (const Part& part : parts)
+    {
+        offsets.push_back(alignOffset(end, part.alignment));
+        end = offsets.back() + part.bytes->size();
+    }
+    out.assign(end, 0);
+
+    std::memcpy(out.data(), Magic, sizeof(Magic));
+    writeAt(out, 4, Version);
+    writeAt(out, 16, static_cast<uint32_t>(parts.size()));
+    for (size_t i = 0; i < parts.size(); ++i)
+    {
+        const size_t entry = HeaderSize + i * EntrySize;
+        writeAt(out, entry, static_cast<uint32_t>(parts[i].type));
+        writeAt(out, entry + 8, static_cast<uint64_t>(offsets[i]));
+        writeAt(out, entry + 16, static_cast<uint64_t>(parts[i].bytes->size()));
+        writeAt(out, entry + 24, parts[i].hash);
+        if (!parts[i].bytes->empty())
+        {
+            std::memcpy(out.data() + offsets[i], parts[i].bytes->data(), parts[i].bytes->size());
+        }
+    }
+
+    const uint64_t checksum = ModelFile::checksum(out.data() + ChecksummedOffset, tableEnd - ChecksummedOffset);
+    writeAt(out, ChecksumOffset, checksum);
+}
+
+bool save(const std::string& path, const Settings& settings, const NormalizationBounds& normalization,
+          const NeuralNetwork* network, const std::vector<char>& dataset, std::string& error)
+{
+    std::vector<char> model, bytes;
+    if (network)
+    {
+        ModelFile::serialize(*network, normalization, model);
+    }
+    serialize(settings, normalization, model, dataset, bytes);
+    return ModelFile::writeBytes(path, bytes, error);
+}
+
+bool load(const std::string& path, Contents& contents, std::string& error)
+{
+    std::shared_ptr<MappedFile> file = MappedFile::open(path, error);
+    std::vector<Section> sections;
+    if (!file || !readTable(file->data(), file->size(), sections, error))
+    {
+        return false;
+    }
+
+    bool hasSettings = false;
+    NormalizationBounds modelNormalization;
+    for (const Section& section : sections)
+    {
+        const char* data = file->data() + section.offset;
+        const size_t size = static_cast<size_t>(section.size);
+        switch (section.type)
+        {
+            case SectionType::Settings:
+            case SectionType::Normalization:
+            {
+                if (ModelFile::checksum(data, size) != section.hash)
+                {
+                    error = "Bundle is corrupt (section checksum mismatch)";
+                    return false;
+                }
+                bool valid = section.type == SectionType::Settings
+                    ? parseSettings(data, size, contents.settings)
+                    : parseNormalization(data, size, contents.normalization);
+                if (!valid)
+                {
+                    error = "Invalid bundle layout";
+                    return false;
+                }
+                hasSettings = hasSettings || section.type == SectionType::Settings;
+                break;
+            }
+            case SectionType::Model:
+            {
+                // The table hash ties the section to this bundle; the model
+                // file's own checksum, verified by the parser, covers its bytes
+                if (ModelFile::contentHash(data, size) != section.hash)
+                {
+                    error = "Bundle is corrupt (model hash mismatch)";
+                    return false;
+                }
+                std::shared_ptr<MappedFile> model = file->view(section.offset, size, error);
+                if (!model)
+                {
+                    return false;
+                }
+                contents.network = ModelFile::parse(model, modelNormalization, contents.folded, error);
+                if (!contents.network)
+                {
+                    error = "Bundle model: " + error;
+                    return false;
+                }
+                contents.modelHash = section.hash;
+                break;
+            }
+            case SectionType::Dataset:
+            {
+                if (DatasetFile::contentHash(data, size) != section.hash)
+                {
+                    error = "Bundle is corrupt (dataset hash mismatch)";
+                    return false;
+                }
+                if (!DatasetFile::parse(data, size, contents.inputs, contents.targets, error))
+                {
+                    error = "Bundle dataset: " + error;
+                    return false;
+                }
+                contents.hasDataset = true;
+                break;
+            }
+            default:
+                // Sections from newer versions are skipped
+                break;
+        }
+    }
+
+    if (!hasSettings)
+    {
+        error = "Bundle has no settings section";
+        return false;
+    }
+    return checkConsistency(contents, modelNormalization, error);
+}
+
+} // namespace ProjectBundle
@@ -0,0 +1,62 @@
+/* TD-NeuroMap Project Bundle
+ * A node's whole state in one file: settings, normalization bounds, model
+ * and dataset. A checksummed section table leads the file. The model and
+ * dataset sections are complete model and dataset file images starting on
+ * MappedFile::ViewAlignment boundaries, so each one maps on its own and is
+ * parsed straight from its view.
+ */
+
+#pragma once
+
+#include "NeuralNetwork.h"
+#include "DataManager.h"
+#include "DatasetFile.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ProjectBundle
+{
+    // Parameter values recorded with the data, so a restore can tell which
+    // ones differ from the node it is loaded into
+    struct Settings
+    {
+        int inputDim = 0;
+        int outputDim = 0;
+        int hiddenLayers = 0;
+        int hiddenUnits = 0;
+        int epochs = 0;
+        float learnRate = 0.0f;
+        bool normalize = false;
+        int activation = 0;                         // ActivationMenuItems
+    };
+
+    struct Contents
+    {
+        Settings settings;
+        NormalizationBounds normalization;          // Empty if the node had none
+        std::unique_ptr<NeuralNetwork> network;     // Null if the node had no model
+        std::unique_ptr<NeuralNetwork> folded;      // Raw-space form, null without normalization
+        uint64_t modelHash = 0;                     // Content hash of the model section
+        bool hasDataset = false;
+        DatasetFile::Samples inputs;
+        DatasetFile::Samples targets;
+    };
+
+    // 'model' and 'dataset' are ModelFile and DatasetFile images; an empty
+    // model image leaves the model section out
+    void serialize(const Settings& settings, const NormalizationBounds& normalization,
+                   const std::vector<char>& model, const std::vector<char>& dataset,
+                   std::vector<char>& out);
+
+    // 'network' may be null
+    bool save(const std::string& path, const Settings& settings, const NormalizationBounds& normalization,
+              const NeuralNetwork* network, const std::vector<char>& dataset, std::string& error);
+
+    // Maps the bundle once, verifies every section's hash and that the
+    // sections agree with each other, and fills 'contents'. The networks
+    // own their weights, so nothing holds the file afterwards. Returns false and sets
+    // 'error' if anything does not verify; 'contents' is then unspecified.
+    bool load(const std::string& path, Contents& contents, std::string& error);
+}
@@ -0,0 +1,136 @@
+/* TD-NeuroMap Pruning Implementation */
+
+#include "Pruning.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+std::vector<uint8_t> Pruning::pruneWeights(NeuralNetwork& network, float sparsity)
+{
+    const DenseLayer* layers = network.getLayers();
+    const int numLayers = network.getNumLayers();
+    float* storage = network.getStorage();
+    std::vector<uint8_t> mask(network.getStorageSize(), 1);
+
+    std::vector<float> magnitudes;
+    for (int l = 0; l < numLayers; ++l)
+    {
+        const int size = layers[l].inputs * layers[l].outputs;
+        for (int i = 0; i < size; ++i)
+        {
+            magnitudes.push_back(std::abs(layers[l].weights[i]));
+        }
+    }
+
+    size_t cut = static_cast<size_t>(std::max(0.0f, std::min(1.0f, sparsity)) * magnitudes.size());
+    if (cut == 0)
+    {
+        return mask;
+    }
+
+    // Global threshold; ties at the threshold are pruned until 'cut' is reached
+    std::nth_element(magnitudes.begin(), magnitudes.begin() + (cut - 1), magnitudes.end());
+    const float threshold = magnitudes[cut - 1];
+    size_t below = 0;
+    for (float m : magnitudes)
+    {
+        if (m < threshold)
+        {
+            ++below;
+        }
+    }
+    size_t atThreshold = cut - below;
+
+    for (int l = 0; l < numLayers; ++l)
+    {
+        float* weights = network.getLayerWeights(l);
+        const size_t base = static_cast<size_t>(weights - storage);
+        const int size = layers[l].inputs * layers[l].outputs;
+        for (int i = 0; i < size; ++i)
+        {
+            float m = std::abs(weights[i]);
+            bool prune = m < threshold;
+            if (!prune && m == threshold && atThreshold > 0)
+            {
+                prune = true;
+                --atThreshold;
+            }
+            if (prune)
+            {
+                weights[i] = 0.0f;
+                mask[base + i] = 0;
+            }
+        }
+    }
+    network.updateKernelWeights();
+    return mask;
+}
+
+std::unique_ptr<NeuralNetwork> Pruning::pruneNeurons(const NeuralNetwork& network, float fraction)
+{
+    const NetworkArchitecture& arch = network.getArchitecture();
+    const DenseLayer* layers = network.getLayers();
+    const int numLayers = network.getNumLayers();
+
+    const int units = arch.hiddenUnits;
+    const float kept = 1.0f - std::max(0.0f, std::min(1.0f, fraction));
+    const int keep = std::max(1, static_cast<int>(std::lround(units * kept)));
+
+    // keepUnits[h] lists the surviving units of hidden layer h, ascending
+    std::vector<std::vector<int>> keepUnits(numLayers - 1);
+    std::vector<float> scores(units);
+    for (int h = 0; h < numLayers - 1; ++h)
+    {
+        const DenseLayer& in = layers[h];
+        const DenseLayer& out = layers[h + 1];
+        for (int u = 0; u < units; ++u)
+        {
+            float inNorm = in.bias[u] * in.bias[u];
+            for (int k = 0; k < in.inputs; ++k)
+            {
+                float w = in.weights[u * in.inputs + k];
+                inNorm += w * w;
+            }
+            float outNorm = 0.0f;
+            for (int j = 0; j < out.outputs; ++j)
+            {
+                float w = out.weights[j * out.inputs + u];
+                outNorm += w * w;
+            }
+            scores[u] = std::sqrt(inNorm) * std::sqrt(outNorm);
+        }
+
+        std::vector<int>& order = keepUnits[h];
+        order.resize(units);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+                         [&scores](int a, int b) { return scores[a] > scores[b]; });
+        order.resize(keep);
+        std::sort(order.begin(), order.end());
+    }
+
+    NetworkArchitecture prunedArch = arch;
+    prunedArch.hiddenUnits = keep;
+    std::unique_ptr<NeuralNetwork> pruned(new NeuralNetwork(prunedArch));
+
+    for (int l = 0; l < numLayers; ++l)
+    {
+        const DenseLayer& src = layers[l];
+        const DenseLayer& dst = pruned->getLayers()[l];
+        float* weights = pruned->getLayerWeights(l);
+        float* bias = pruned->getLayerBias(l);
+
+        for (int j = 0; j < dst.outputs; ++j)
+        {
+            int row = (l < numLayers - 1) ? keepUnits[l][j] : j;
+            bias[j] = src.bias[row];
+            for (int k = 0; k < dst.inputs; ++k)
+            {
+                int col = (l > 0) ? keepUnits[l - 1][k] : k;
+                weights[j * dst.inputs + k] = src.weights[row * src.inputs + col];
+            }
+        }
+    }
+    pruned->updateKernelWeights();
+    return pruned;
+}
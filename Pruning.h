@@ -0,0 +1,25 @@
+/* TD-NeuroMap Pruning
+ * Post-training removal of low-magnitude weights or whole hidden neurons.
+ * Weight pruning keeps the dense layout and zeroes connections, for a
+ * SparseNetwork to skip; neuron pruning builds a narrower dense network.
+ */
+
+#pragma once
+
+#include "NeuralNetwork.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Pruning
+{
+    // Zeroes the 'sparsity' fraction of weights with the smallest magnitude,
+    // ranked across all layers; biases are kept. Returns a storage-layout
+    // mask (1 = trainable) for Trainer::setMask.
+    std::vector<uint8_t> pruneWeights(NeuralNetwork& network, float sparsity);
+
+    // Removes the 'fraction' of units in every hidden layer with the least
+    // influence, scored as |incoming weights| * |outgoing weights|. The
+    // returned network has the same function shape with fewer hidden units.
+    std::unique_ptr<NeuralNetwork> pruneNeurons(const NeuralNetwork& network, float fraction);
+}
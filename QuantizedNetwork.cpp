@@ -0,0 +1,219 @@
+/* TD-NeuroMap Quantized Network Implementation */
+
+#include "QuantizedNetwork.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+
+namespace
+{
+    inline int8_t quantize(float value, float invScale, int limit)
+    {
+        float scaled = value * invScale;
+        scaled = std::max(static_cast<float>(-limit), std::min(static_cast<float>(limit), scaled));
+        return static_cast<int8_t>(scaled >= 0.0f ? scaled + 0.5f : scaled - 0.5f);
+    }
+
+    inline int padTo(int value, int multiple)
+    {
+        return (value + multiple - 1) / multiple * multiple;
+    }
+}
+
+QuantizedNetwork::QuantizedNetwork(const NeuralNetwork& network,
+                                   const std::vector<std::vector<float>>& calibration,
+                                   ActivationPrecision precision)
+    : m_arch(network.getArchitecture())
+    , m_kernels(SimdKernels::getInt8Kernels())
+    , m_widestPadded(0)
+    , m_meanError(0.0f)
+    , m_maxError(0.0f)
+    , m_errorPrecision(precision)
+{
+    const DenseLayer* layers = network.getLayers();
+    const int numLayers = network.getNumLayers();
+
+    // Without a dataset, calibrate on the normalized input range
+    std::vector<std::vector<float>> samples = calibration.empty() ? uniformSamples(m_arch.inputDim) : calibration;
+
+    // Record the largest magnitude seen at each layer input
+    std::vector<float> inputMaxAbs(numLayers, 0.0f);
+    std::vector<float> current, next;
+    for (const auto& sample : samples)
+    {
+        current.assign(sample.begin(), sample.end());
+        current.resize(m_arch.inputDim, 0.0f);
+
+        for (int l = 0; l < numLayers; ++l)
+        {
+            const DenseLayer& layer = layers[l];
+            for (float value : current)
+                inputMaxAbs[l] = std::max(inputMaxAbs[l], std::abs(value));
+
+            next.resize(layer.outputs);
+            for (int j = 0; j < layer.outputs; ++j)
+            {
+                float acc = layer.bias[j];
+                for (int k = 0; k < layer.inputs; ++k)
+                    acc += layer.weights[j * layer.inputs + k] * current[k];
+                next[j] = (l == numLayers - 1) ? acc : std::tanh(acc);
+            }
+            std::swap(current, next);
+        }
+    }
+
+    const int limit = m_kernels.weightLimit;
+    for (int l = 0; l < numLayers; ++l)
+    {
+        const DenseLayer& layer = layers[l];
+        QuantizedLayer q;
+        q.inputs = layer.inputs;
+        q.paddedInputs = l == 0 ? padTo(layer.inputs, 4) : m_layers.back().paddedOutputs;
+        q.outputs = layer.outputs;
+        q.paddedOutputs = padTo(layer.outputs, 16);
+        float inputScale = inputMaxAbs[l] > 0.0f ? inputMaxAbs[l] / 127.0f : 1.0f / 127.0f;
+        q.invInputScale = 1.0f / inputScale;
+        q.weights.assign(static_cast<size_t>(q.paddedOutputs) * q.paddedInputs, 0);
+        q.correction.assign(q.paddedOutputs, 0);
+        q.outputScale.assign(q.paddedOutputs, 0.0f);
+        q.bias.assign(q.paddedOutputs, 0.0f);
+        std::copy(layer.bias, layer.bias + layer.outputs, q.bias.begin());
+
+        for (int j = 0; j < layer.outputs; ++j)
+        {
+            const float* row = layer.weights + j * layer.inputs;
+            float rowMax = 0.0f;
+            for (int k = 0; k < layer.inputs; ++k)
+                rowMax = std::max(rowMax, std::abs(row[k]));
+
+            // Row j, column k sits in 16-row block j / 16 at [k / 4][j % 16][k % 4]
+            float weightScale = rowMax > 0.0f ? rowMax / limit : 1.0f;
+            int8_t* block = q.weights.data() + static_cast<size_t>(j / 16) * 16 * q.paddedInputs;
+            int rowSum = 0;
+            for (int k = 0; k < layer.inputs; ++k)
+            {
+                int8_t value = quantize(row[k], 1.0f / weightScale, limit);
+                block[(k / 4) * 64 + (j % 16) * 4 + k % 4] = value;
+                rowSum += value;
+            }
+            q.correction[j] = -SimdKernels::Int8ZeroPoint * rowSum;
+            q.outputScale[j] = weightScale * inputScale;
+        }
+
+        m_widestPadded = std::max(m_widestPadded, std::max(q.paddedInputs, q.paddedOutputs));
+        m_layers.push_back(std::move(q));
+    }
+
+    measureError(network, samples, precision);
+}
+
+std::vector<std::vector<float>> QuantizedNetwork::uniformSamples(int inputDim)
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    std::vector<std::vector<float>> samples(256, std::vector<float>(inputDim));
+    for (auto& sample : samples)
+    {
+        for (float& value : sample)
+            value = dist(rng);
+    }
+    return samples;
+}
+
+void QuantizedNetwork::forwardBatch(const float* const* inputs, float* const* outputs, int count, float* scratch,
+                                    ActivationPrecision) const
+{
+    const int tile = SimdKernels::TileWidth;
+    float* x = scratch;
+    int32_t* acc = reinterpret_cast<int32_t*>(x + tile * m_widestPadded);
+    uint8_t* q = reinterpret_cast<uint8_t*>(acc + tile * m_widestPadded);
+
+    const int numLayers = static_cast<int>(m_layers.size());
+    const QuantizedLayer& first = m_layers.front();
+    const QuantizedLayer& last = m_layers.back();
+
+    for (int base = 0; base < count; base += tile)
+    {
+        int samples = std::min(tile, count - base);
+
+        // Gather [sample][dim]; padding and missing samples are zero
+        for (int s = 0; s < tile; ++s)
+        {
+            float* xs = x + s * first.paddedInputs;
+            for (int k = 0; k < first.paddedInputs; ++k)
+                xs[k] = (s < samples && k < first.inputs) ? inputs[k][base + s] : 0.0f;
+        }
+
+        // Each layer's input is quantized once for the whole tile, and its
+        // output dequantized in place of that input. Hidden outputs are
+        // requantized right away, so the rational tanh is used at either
+        // precision: its error is far below one int8 step.
+        for (int l = 0; l < numLayers; ++l)
+        {
+            const QuantizedLayer& layer = m_layers[l];
+            m_kernels.quantize(x, tile * layer.paddedInputs, layer.invInputScale, q);
+            m_kernels.matMul(layer.weights.data(), layer.paddedOutputs, layer.paddedInputs, q, acc);
+            m_kernels.dequantize(acc, layer.paddedOutputs, layer.correction.data(), layer.outputScale.data(),
+                                 layer.bias.data(), x, l < numLayers - 1);
+        }
+
+        for (int s = 0; s < samples; ++s)
+        {
+            for (int j = 0; j < m_arch.outputDim; ++j)
+                outputs[j][base + s] = x[s * last.paddedOutputs + j];
+        }
+    }
+}
+
+int QuantizedNetwork::getScratchSize() const
+{
+    const int tile = SimdKernels::TileWidth;
+    return tile * m_widestPadded          // float activations
+         + tile * m_widestPadded          // int32 accumulators
+         + tile * m_widestPadded / 4;     // uint8 quantized activations
+}
+
+void QuantizedNetwork::measureError(const NeuralNetwork& network,
+                                    const std::vector<std::vector<float>>& calibration,
+                                    ActivationPrecision precision)
+{
+    const int count = static_cast<int>(calibration.size());
+
+    // Channel-major copies so both networks go through their batched paths
+    std::vector<float> input(static_cast<size_t>(m_arch.inputDim) * count);
+    std::vector<float> reference(static_cast<size_t>(m_arch.outputDim) * count);
+    std::vector<float> quantized(static_cast<size_t>(m_arch.outputDim) * count);
+    std::vector<const float*> inputChannels(m_arch.inputDim);
+    std::vector<float*> referenceChannels(m_arch.outputDim);
+    std::vector<float*> quantizedChannels(m_arch.outputDim);
+
+    for (int k = 0; k < m_arch.inputDim; ++k)
+    {
+        float* channel = input.data() + static_cast<size_t>(k) * count;
+        for (int s = 0; s < count; ++s)
+            channel[s] = k < static_cast<int>(calibration[s].size()) ? calibration[s][k] : 0.0f;
+        inputChannels[k] = channel;
+    }
+    for (int j = 0; j < m_arch.outputDim; ++j)
+    {
+        referenceChannels[j] = reference.data() + static_cast<size_t>(j) * count;
+        quantizedChannels[j] = quantized.data() + static_cast<size_t>(j) * count;
+    }
+
+    AlignedBuffer referenceScratch(network.getBatchScratchSize());
+    AlignedBuffer quantizedScratch(getScratchSize());
+    network.forwardBatch(inputChannels.data(), referenceChannels.data(), count, referenceScratch.data(), precision);
+    forwardBatch(inputChannels.data(), quantizedChannels.data(), count, quantizedScratch.data(), precision);
+
+    double sum = 0.0;
+    m_maxError = 0.0f;
+    for (size_t i = 0; i < reference.size(); ++i)
+    {
+        float error = std::abs(reference[i] - quantized[i]);
+        sum += error;
+        m_maxError = std::max(m_maxError, error);
+    }
+
+    m_meanError = reference.empty() ? 0.0f : static_cast<float>(sum / reference.size());
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+/* TD-NeuroMap Quantized Network
+ * Post-training int8 quantization of a NeuralNetwork.
+ * Weights use a symmetric per-row scale; layer inputs use a symmetric
+ * per-layer scale calibrated from representative samples. Samples run in
+ * tiles: each layer input is quantized once per tile and multiplied as
+ * u8 x s8 by the SimdKernels int8 kernels.
+ */
+
+#pragma once
+
+#include "NeuralNetwork.h"
+#include "SimdKernels.h"
+#include <cstdint>
+#include <vector>
+
+class QuantizedNetwork
+{
+public:
+    // 'calibration' holds network-space (normalized) input samples. The
+    // error is measured with 'precision' hidden activations on both models,
+    // the precision Run mode passes to forwardBatch.
+    QuantizedNetwork(const NeuralNetwork& network, const std::vector<std::vector<float>>& calibration,
+                     ActivationPrecision precision);
+
+    // The samples an empty calibration set falls back to: 256 uniform
+    // points over the normalized input range
+    static std::vector<std::vector<float>> uniformSamples(int inputDim);
+
+    // Same contract as NeuralNetwork::forwardBatch; 'scratch' must hold
+    // getScratchSize() floats, 64-byte aligned. Hidden layers always use the
+    // rational tanh, so 'precision' does not change the result.
+    void forwardBatch(const float* const* inputs, float* const* outputs, int count, float* scratch,
+                      ActivationPrecision precision = ActivationPrecision::Exact) const;
+    int getScratchSize() const;
+
+    // Output error against the fp32 network over the calibration set, in
+    // network output units (fractions of the output range when normalized)
+    float getMeanError() const { return m_meanError; }
+    float getMaxError() const { return m_maxError; }
+    ActivationPrecision getErrorPrecision() const { return m_errorPrecision; }
+
+    const NetworkArchitecture& getArchitecture() const { return m_arch; }
+    const char* getKernelName() const { return m_kernels.name; }
+
+private:
+    struct QuantizedLayer
+    {
+        int inputs;
+        int paddedInputs;                   // Multiple of 4; the previous layer's paddedOutputs
+        int outputs;
+        int paddedOutputs;                  // Multiple of 16
+        float invInputScale;                // int8 steps per real unit of the layer input
+        std::vector<int8_t> weights;        // Packed for SimdKernels::MatMulInt8Fn
+        std::vector<int32_t> correction;    // -Int8ZeroPoint * row sum, removes the input offset
+        std::vector<float> outputScale;     // weight row scale * input scale, zero in the padding
+        std::vector<float> bias;            // Zero in the padding
+    };
+
+    NetworkArchitecture m_arch;
+    std::vector<QuantizedLayer> m_layers;
+    SimdKernels::Int8Kernels m_kernels;
+    int m_widestPadded;
+    float m_meanError;
+    float m_maxError;
+    ActivationPrecision m_errorPrecision;
+
+    void measureError(const NeuralNetwork& network, const std::vector<std::vector<float>>& calibration,
+                      ActivationPrecision precision);
+};
\ No newline at end of file
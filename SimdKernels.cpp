@@ -0,0 +1,1229 @@
+/* TD-NeuroMap SIMD Kernels Implementation
+ * Each instruction set gets its own function compiled with a target
+ * attribute, so a single universal build carries every variant and the
+ * dispatcher picks one at runtime.
+ */
+
+#include "SimdKernels.h"
+#include "CpuFeatures.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define NEUROMAP_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#define NEUROMAP_TARGET(isa)
+#else
+#define NEUROMAP_TARGET(isa) __attribute__((target(isa)))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define NEUROMAP_ARM64 1
+#include <arm_neon.h>
+#endif
+
+// Fully unrolls a loop with a compile-time trip count, so arrays indexed by
+// its counter become registers
+#if defined(__clang__)
+#define NEUROMAP_UNROLL _Pragma("unroll")
+#elif defined(__GNUC__)
+#define NEUROMAP_UNROLL _Pragma("GCC unroll 16")
+#else
+#define NEUROMAP_UNROLL
+#endif
+
+namespace
+{
+    using SimdKernels::TileWidth;
+
+    void applyTanh(float* y, int rows)
+    {
+        for (int i = 0; i < rows * TileWidth; ++i)
+        {
+            y[i] = std::tanh(y[i]);
+        }
+    }
+
+    using InferenceKernels::TanhClamp;
+    using InferenceKernels::TanhAlpha1;
+    using InferenceKernels::TanhAlpha3;
+    using InferenceKernels::TanhAlpha5;
+    using InferenceKernels::TanhAlpha7;
+    using InferenceKernels::TanhAlpha9;
+    using InferenceKernels::TanhAlpha11;
+    using InferenceKernels::TanhAlpha13;
+    using InferenceKernels::TanhBeta0;
+    using InferenceKernels::TanhBeta2;
+    using InferenceKernels::TanhBeta4;
+    using InferenceKernels::TanhBeta6;
+
+    // Fast kernels apply the rational tanh to the accumulators before the
+    // store; Exact kernels store and then call std::tanh over the rows
+    template <bool Fast>
+    void denseTileScalar(const DenseLayer& layer, const float* x, float* y, bool hidden)
+    {
+        for (int j = 0; j < layer.outputs; ++j)
+        {
+            const float* row = layer.weights + j * layer.inputs;
+            float acc[TileWidth];
+            for (int lane = 0; lane < TileWidth; ++lane)
+            {
+                acc[lane] = layer.bias[j];
+            }
+            for (int k = 0; k < layer.inputs; ++k)
+            {
+                const float w = row[k];
+                const float* xk = x + k * TileWidth;
+                for (int lane = 0; lane < TileWidth; ++lane)
+                {
+                    acc[lane] += w * xk[lane];
+                }
+            }
+            for (int lane = 0; lane < TileWidth; ++lane)
+            {
+                y[j * TileWidth + lane] = (Fast && hidden) ? InferenceKernels::fastTanh(acc[lane]) : acc[lane];
+            }
+        }
+
+        if (!Fast && hidden)
+            applyTanh(y, layer.outputs);
+    }
+
+#ifdef NEUROMAP_X86
+    NEUROMAP_TARGET("sse2")
+    inline __m128 fastTanhSSE(__m128 x)
+    {
+        x = _mm_max_ps(_mm_set1_ps(-TanhClamp), _mm_min_ps(_mm_set1_ps(TanhClamp), x));
+        const __m128 x2 = _mm_mul_ps(x, x);
+        __m128 p = _mm_set1_ps(TanhAlpha13);
+        p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(TanhAlpha11));
+        p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(TanhAlpha9));
+        p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(TanhAlpha7));
+        p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(TanhAlpha5));
+        p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(TanhAlpha3));
+        p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(TanhAlpha1));
+        __m128 q = _mm_set1_ps(TanhBeta6);
+        q = _mm_add_ps(_mm_mul_ps(q, x2), _mm_set1_ps(TanhBeta4));
+        q = _mm_add_ps(_mm_mul_ps(q, x2), _mm_set1_ps(TanhBeta2));
+        q = _mm_add_ps(_mm_mul_ps(q, x2), _mm_set1_ps(TanhBeta0));
+        return _mm_div_ps(_mm_mul_ps(x, p), q);
+    }
+
+    template <bool Fast>
+    NEUROMAP_TARGET("sse2")
+    void denseTileSSE(const DenseLayer& layer, const float* x, float* y, bool hidden)
+    {
+        for (int j = 0; j < layer.outputs; ++j)
+        {
+            const float* row = layer.weights + j * layer.inputs;
+            __m128 acc0 = _mm_set1_ps(layer.bias[j]);
+            __m128 acc1 = acc0;
+            __m128 acc2 = acc0;
+            __m128 acc3 = acc0;
+            for (int k = 0; k < layer.inputs; ++k)
+            {
+                const __m128 w = _mm_set1_ps(row[k]);
+                const float* xk = x + k * TileWidth;
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(w, _mm_load_ps(xk)));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(w, _mm_load_ps(xk + 4)));
+                acc2 = _mm_add_ps(acc2, _mm_mul_ps(w, _mm_load_ps(xk + 8)));
+                acc3 = _mm_add_ps(acc3, _mm_mul_ps(w, _mm_load_ps(xk + 12)));
+            }
+            if (Fast && hidden)
+            {
+                acc0 = fastTanhSSE(acc0);
+                acc1 = fastTanhSSE(acc1);
+                acc2 = fastTanhSSE(acc2);
+                acc3 = fastTanhSSE(acc3);
+            }
+            float* yj = y + j * TileWidth;
+            _mm_store_ps(yj, acc0);
+            _mm_store_ps(yj + 4, acc1);
+            _mm_store_ps(yj + 8, acc2);
+            _mm_store_ps(yj + 12, acc3);
+        }
+
+        if (!Fast && hidden)
+            applyTanh(y, layer.outputs);
+    }
+
+    NEUROMAP_TARGET("avx2,fma")
+    inline __m256 fastTanhAVX2(__m256 x)
+    {
+        x = _mm256_max_ps(_mm256_set1_ps(-TanhClamp), _mm256_min_ps(_mm256_set1_ps(TanhClamp), x));
+        const __m256 x2 = _mm256_mul_ps(x, x);
+        __m256 p = _mm256_set1_ps(TanhAlpha13);
+        p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(TanhAlpha11));
+        p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(TanhAlpha9));
+        p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(TanhAlpha7));
+        p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(TanhAlpha5));
+        p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(TanhAlpha3));
+        p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(TanhAlpha1));
+        __m256 q = _mm256_set1_ps(TanhBeta6);
+        q = _mm256_fmadd_ps(q, x2, _mm256_set1_ps(TanhBeta4));
+        q = _mm256_fmadd_ps(q, x2, _mm256_set1_ps(TanhBeta2));
+        q = _mm256_fmadd_ps(q, x2, _mm256_set1_ps(TanhBeta0));
+        return _mm256_div_ps(_mm256_mul_ps(x, p), q);
+    }
+
+    template <bool Fast>
+    NEUROMAP_TARGET("avx2,fma")
+    void denseTileAVX2(const DenseLayer& layer, const float* x, float* y, bool hidden)
+    {
+        for (int j = 0; j < layer.outputs; ++j)
+        {
+            const float* row = layer.weights + j * layer.inputs;
+            __m256 acc0 = _mm256_set1_ps(layer.bias[j]);
+            __m256 acc1 = acc0;
+            for (int k = 0; k < layer.inputs; ++k)
+            {
+                const __m256 w = _mm256_set1_ps(row[k]);
+                const float* xk = x + k * TileWidth;
+                acc0 = _mm256_fmadd_ps(w, _mm256_load_ps(xk), acc0);
+                acc1 = _mm256_fmadd_ps(w, _mm256_load_ps(xk + 8), acc1);
+            }
+            if (Fast && hidden)
+            {
+                acc0 = fastTanhAVX2(acc0);
+                acc1 = fastTanhAVX2(acc1);
+            }
+            float* yj = y + j * TileWidth;
+            _mm256_store_ps(yj, acc0);
+            _mm256_store_ps(yj + 8, acc1);
+        }
+
+        if (!Fast && hidden)
+            applyTanh(y, layer.outputs);
+    }
+
+    NEUROMAP_TARGET("avx512f")
+    inline __m512 fastTanhAVX512(__m512 x)
+    {
+        x = _mm512_max_ps(_mm512_set1_ps(-TanhClamp), _mm512_min_ps(_mm512_set1_ps(TanhClamp), x));
+        const __m512 x2 = _mm512_mul_ps(x, x);
+        __m512 p = _mm512_set1_ps(TanhAlpha13);
+        p = _mm512_fmadd_ps(p, x2, _mm512_set1_ps(TanhAlpha11));
+        p = _mm512_fmadd_ps(p, x2, _mm512_set1_ps(TanhAlpha9));
+        p = _mm512_fmadd_ps(p, x2, _mm512_set1_ps(TanhAlpha7));
+        p = _mm512_fmadd_ps(p, x2, _mm512_set1_ps(TanhAlpha5));
+        p = _mm512_fmadd_ps(p, x2, _mm512_set1_ps(TanhAlpha3));
+        p = _mm512_fmadd_ps(p, x2, _mm512_set1_ps(TanhAlpha1));
+        __m512 q = _mm512_set1_ps(TanhBeta6);
+        q = _mm512_fmadd_ps(q, x2, _mm512_set1_ps(TanhBeta4));
+        q = _mm512_fmadd_ps(q, x2, _mm512_set1_ps(TanhBeta2));
+        q = _mm512_fmadd_ps(q, x2, _mm512_set1_ps(TanhBeta0));
+        return _mm512_div_ps(_mm512_mul_ps(x, p), q);
+    }
+
+    template <bool Fast>
+    NEUROMAP_TARGET("avx512f")
+    void denseTileAVX512(const DenseLayer& layer, const float* x, float* y, bool hidden)
+    {
+        // Two output rows per pass so consecutive FMAs are independent
+        int j = 0;
+        for (; j + 1 < layer.outputs; j += 2)
+        {
+            const float* row0 = layer.weights + j * layer.inputs;
+            const float* row1 = row0 + layer.inputs;
+            __m512 acc0 = _mm512_set1_ps(layer.bias[j]);
+            __m512 acc1 = _mm512_set1_ps(layer.bias[j + 1]);
+            for (int k = 0; k < layer.inputs; ++k)
+            {
+                const __m512 xk = _mm512_load_ps(x + k * TileWidth);
+                acc0 = _mm512_fmadd_ps(_mm512_set1_ps(row0[k]), xk, acc0);
+                acc1 = _mm512_fmadd_ps(_mm512_set1_ps(row1[k]), xk, acc1);
+            }
+            if (Fast && hidden)
+            {
+                acc0 = fastTanhAVX512(acc0);
+                acc1 = fastTanhAVX512(acc1);
+            }
+            _mm512_store_ps(y + j * TileWidth, acc0);
+            _mm512_store_ps(y + (j + 1) * TileWidth, acc1);
+        }
+        for (; j < layer.outputs; ++j)
+        {
+            const float* row = layer.weights + j * layer.inputs;
+            __m512 acc = _mm512_set1_ps(layer.bias[j]);
+            for (int k = 0; k < layer.inputs; ++k)
+            {
+                acc = _mm512_fmadd_ps(_mm512_set1_ps(row[k]), _mm512_load_ps(x + k * TileWidth), acc);
+            }
+            if (Fast && hidden)
+                acc = fastTanhAVX512(acc);
+            _mm512_store_ps(y + j * TileWidth, acc);
+        }
+
+        if (!Fast && hidden)
+            applyTanh(y, layer.outputs);
+    }
+#endif
+
+#ifdef NEUROMAP_ARM64
+    inline float32x4_t fastTanhNEON(float32x4_t x)
+    {
+        x = vmaxq_f32(vdupq_n_f32(-TanhClamp), vminq_f32(vdupq_n_f32(TanhClamp), x));
+        const float32x4_t x2 = vmulq_f32(x, x);
+        float32x4_t p = vdupq_n_f32(TanhAlpha13);
+        p = vfmaq_f32(vdupq_n_f32(TanhAlpha11), p, x2);
+        p = vfmaq_f32(vdupq_n_f32(TanhAlpha9), p, x2);
+        p = vfmaq_f32(vdupq_n_f32(TanhAlpha7), p, x2);
+        p = vfmaq_f32(vdupq_n_f32(TanhAlpha5), p, x2);
+        p = vfmaq_f32(vdupq_n_f32(TanhAlpha3), p, x2);
+        p = vfmaq_f32(vdupq_n_f32(TanhAlpha1), p, x2);
+        float32x4_t q = vdupq_n_f32(TanhBeta6);
+        q = vfmaq_f32(vdupq_n_f32(TanhBeta4), q, x2);
+        q = vfmaq_f32(vdupq_n_f32(TanhBeta2), q, x2);
+        q = vfmaq_f32(vdupq_n_f32(TanhBeta0), q, x2);
+        return vdivq_f32(vmulq_f32(x, p), q);
+    }
+
+    template <bool Fast>
+    void denseTileNEON(const DenseLayer& layer, const float* x, float* y, bool hidden)
+    {
+        for (int j = 0; j < layer.outputs; ++j)
+        {
+            const float* row = layer.weights + j * layer.inputs;
+            float32x4_t acc0 = vdupq_n_f32(layer.bias[j]);
+            float32x4_t acc1 = acc0;
+            float32x4_t acc2 = acc0;
+            float32x4_t acc3 = acc0;
+            for (int k = 0; k < layer.inputs; ++k)
+            {
+                const float32x4_t w = vdupq_n_f32(row[k]);
+                const float* xk = x + k * TileWidth;
+                acc0 = vfmaq_f32(acc0, w, vld1q_f32(xk));
+                acc1 = vfmaq_f32(acc1, w, vld1q_f32(xk + 4));
+                acc2 = vfmaq_f32(acc2, w, vld1q_f32(xk + 8));
+                acc3 = vfmaq_f32(acc3, w, vld1q_f32(xk + 12));
+            }
+            if (Fast && hidden)
+            {
+                acc0 = fastTanhNEON(acc0);
+                acc1 = fastTanhNEON(acc1);
+                acc2 = fastTanhNEON(acc2);
+                acc3 = fastTanhNEON(acc3);
+            }
+            float* yj = y + j * TileWidth;
+            vst1q_f32(yj, acc0);
+            vst1q_f32(yj + 4, acc1);
+            vst1q_f32(yj + 8, acc2);
+            vst1q_f32(yj + 12, acc3);
+        }
+
+        if (!Fast && hidden)
+            applyTanh(y, layer.outputs);
+    }
+#endif
+
+    // Single-sample layers on column-major weights (InferenceKernels::
+    // packColumns): y[0..M) = bias + sum_k W[:,k] * x[k], with each input
+    // broadcast and multiplied into output vectors held in registers. Narrow
+    // layers alternate inputs between Sums sets of accumulators, added in a
+    // fixed order at the end, so at least eight FMAs are in flight. 'y'
+    // holds columnStride(M) floats.
+    template <int Vectors>
+    constexpr int columnSums()
+    {
+        return Vectors >= 8 ? 1 : 8 / Vectors;
+    }
+
+    template <int N, int M, bool Hidden, bool Fast>
+    struct ColumnsScalar
+    {
+        static void apply(const DenseLayer& layer, const float* x, float* y)
+        {
+            float acc[M];
+            for (int j = 0; j < M; ++j)
+            {
+                acc[j] = layer.bias[j];
+            }
+            for (int k = 0; k < N; ++k)
+            {
+                const float* column = layer.weights + k * InferenceKernels::columnStride(M);
+                for (int j = 0; j < M; ++j)
+                {
+                    acc[j] += column[j] * x[k];
+                }
+            }
+            for (int j = 0; j < M; ++j)
+            {
+                y[j] = !Hidden ? acc[j] : Fast ? InferenceKernels::fastTanh(acc[j]) : std::tanh(acc[j]);
+            }
+        }
+    };
+
+#ifdef NEUROMAP_X86
+    template <int N, int M, bool Hidden, bool Fast>
+    struct ColumnsSSE
+    {
+        NEUROMAP_TARGET("sse2")
+        static void apply(const DenseLayer& layer, const float* x, float* y)
+        {
+            constexpr int Vectors = (M + 3) / 4;
+            constexpr int Sums = columnSums<Vectors>();
+            constexpr int Stride = InferenceKernels::columnStride(M);
+            constexpr int Whole = N / Sums * Sums;
+            __m128 acc[Sums][Vectors];
+            NEUROMAP_UNROLL
+            for (int v = 0; v < Vectors; ++v)
+            {
+                acc[0][v] = _mm_load_ps(layer.bias + 4 * v);
+                NEUROMAP_UNROLL
+                for (int s = 1; s < Sums; ++s)
+                    acc[s][v] = _mm_setzero_ps();
+            }
+            for (int k = 0; k < Whole; k += Sums)
+            {
+                NEUROMAP_UNROLL
+                for (int s = 0; s < Sums; ++s)
+                {
+                    const __m128 xk = _mm_set1_ps(x[k + s]);
+                    const float* column = layer.weights + (k + s) * Stride;
+                    NEUROMAP_UNROLL
+                    for (int v = 0; v < Vectors; ++v)
+                        acc[s][v] = _mm_add_ps(acc[s][v], _mm_mul_ps(_mm_load_ps(column + 4 * v), xk));
+                }
+            }
+            for (int k = Whole; k < N; ++k)
+            {
+                const __m128 xk = _mm_set1_ps(x[k]);
+                const float* column = layer.weights + k * Stride;
+                NEUROMAP_UNROLL
+                for (int v = 0; v < Vectors; ++v)
+                    acc[0][v] = _mm_add_ps(acc[0][v], _mm_mul_ps(_mm_load_ps(column + 4 * v), xk));
+            }
+            NEUROMAP_UNROLL
+            for (int v = 0; v < Vectors; ++v)
+            {
+                NEUROMAP_UNROLL
+                for (int s = 1; s < Sums; ++s)
+                    acc[0][v] = _mm_add_ps(acc[0][v], acc[s][v]);
+                _mm_store_ps(y + 4 * v, Hidden && Fast ? fastTanhSSE(acc[0][v]) : acc[0][v]);
+            }
+            if (Hidden && !Fast)
+            {
+                for (int j = 0; j < M; ++j)
+                    y[j] = std::tanh(y[j]);
+            }
+        }
+    };
+
+    template <int N, int M, bool Hidden, bool Fast>
+    struct ColumnsAVX2
+    {
+        NEUROMAP_TARGET("avx2,fma")
+        static void apply(const DenseLayer& layer, const float* x, float* y)
+        {
+            constexpr int Vectors = (M + 7) / 8;
+            constexpr int Sums = columnSums<Vectors>();
+            constexpr int Stride = InferenceKernels::columnStride(M);
+            constexpr int Whole = N / Sums * Sums;
+            __m256 acc[Sums][Vectors];
+            NEUROMAP_UNROLL
+            for (int v = 0; v < Vectors; ++v)
+            {
+                acc[0][v] = _mm256_load_ps(layer.bias + 8 * v);
+                NEUROMAP_UNROLL
+                for (int s = 1; s < Sums; ++s)
+                    acc[s][v] = _mm256_setzero_ps();
+            }
+            for (int k = 0; k < Whole; k += Sums)
+            {
+                NEUROMAP_UNROLL
+                for (int s = 0; s < Sums; ++s)
+                {
+                    const __m256 xk = _mm256_set1_ps(x[k + s]);
+                    const float* column = layer.weights + (k + s) * Stride;
+                    NEUROMAP_UNROLL
+                    for (int v = 0; v < Vectors; ++v)
+                        acc[s][v] = _mm256_fmadd_ps(_mm256_load_ps(column + 8 * v), xk, acc[s][v]);
+                }
+            }
+            for (int k = Whole; k < N; ++k)
+            {
+                const __m256 xk = _mm256_set1_ps(x[k]);
+                const float* column = layer.weights + k * Stride;
+                NEUROMAP_UNROLL
+                for (int v = 0; v < Vectors; ++v)
+                    acc[0][v] = _mm256_fmadd_ps(_mm256_load_ps(column + 8 * v), xk, acc[0][v]);
+            }
+            NEUROMAP_UNROLL
+            for (int v = 0; v < Vectors; ++v)
+            {
+                NEUROMAP_UNROLL
+                for (int s = 1; s < Sums; ++s)
+                    acc[0][v] = _mm256_add_ps(acc[0][v], acc[s][v]);
+                _mm256_store_ps(y + 8 * v, Hidden && Fast ? fastTanhAVX2(acc[0][v]) : acc[0][v]);
+            }
+            if (Hidden && !Fast)
+            {
+                for (int j = 0; j < M; ++j)
+                    y[j] = std::tanh(y[j]);
+            }
+        }
+    };
+
+    template <int N, int M, bool Hidden, bool Fast>
+    struct ColumnsAVX512
+    {
+        NEUROMAP_TARGET("avx512f")
+        static void apply(const DenseLayer& layer, const float* x, float* y)
+        {
+            constexpr int Vectors = (M + 15) / 16;
+            constexpr int Sums = columnSums<Vectors>();
+            constexpr int Stride = InferenceKernels::columnStride(M);
+            constexpr int Whole = N / Sums * Sums;
+            __m512 acc[Sums][Vectors];
+            NEUROMAP_UNROLL
+            for (int v = 0; v < Vectors; ++v)
+            {
+                acc[0][v] = _mm512_load_ps(layer.bias + 16 * v);
+                NEUROMAP_UNROLL
+                for (int s = 1; s < Sums; ++s)
+                    acc[s][v] = _mm512_setzero_ps();
+            }
+            for (int k = 0; k < Whole; k += Sums)
+            {
+                NEUROMAP_UNROLL
+                for (int s = 0; s < Sums; ++s)
+                {
+                    const __m512 xk = _mm512_set1_ps(x[k + s]);
+                    const float* column = layer.weights + (k + s) * Stride;
+                    NEUROMAP_UNROLL
+                    for (int v = 0; v < Vectors; ++v)
+                        acc[s][v] = _mm512_fmadd_ps(_mm512_load_ps(column + 16 * v), xk, acc[s][v]);
+                }
+            }
+            for (int k = Whole; k < N; ++k)
+            {
+                const __m512 xk = _mm512_set1_ps(x[k]);
+                const float* column = layer.weights + k * Stride;
+                NEUROMAP_UNROLL
+                for (int v = 0; v < Vectors; ++v)
+                    acc[0][v] = _mm512_fmadd_ps(_mm512_load_ps(column + 16 * v), xk, acc[0][v]);
+            }
+            NEUROMAP_UNROLL
+            for (int v = 0; v < Vectors; ++v)
+            {
+                NEUROMAP_UNROLL
+                for (int s = 1; s < Sums; ++s)
+                    acc[0][v] = _mm512_add_ps(acc[0][v], acc[s][v]);
+                _mm512_store_ps(y + 16 * v, Hidden && Fast ? fastTanhAVX512(acc[0][v]) : acc[0][v]);
+            }
+            if (Hidden && !Fast)
+            {
+                for (int j = 0; j < M; ++j)
+                    y[j] = std::tanh(y[j]);
+            }
+        }
+    };
+#endif
+
+#ifdef NEUROMAP_ARM64
+    template <int N, int M, bool Hidden, bool Fast>
+    struct ColumnsNEON
+    {
+        static void apply(const DenseLayer& layer, const float* x, float* y)
+        {
+            constexpr int Vectors = (M + 3) / 4;
+            constexpr int Sums = columnSums<Vectors>();
+            constexpr int Stride = InferenceKernels::columnStride(M);
+            constexpr int Whole = N / Sums * Sums;
+            float32x4_t acc[Sums][Vectors];
+            NEUROMAP_UNROLL
+            for (int v = 0; v < Vectors; ++v)
+            {
+                acc[0][v] = vld1q_f32(layer.bias + 4 * v);
+                NEUROMAP_UNROLL
+                for (int s = 1; s < Sums; ++s)
+                    acc[s][v] = vdupq_n_f32(0.0f);
+            }
+            for (int k = 0; k < Whole; k += Sums)
+            {
+                NEUROMAP_UNROLL
+                for (int s = 0; s < Sums; ++s)
+                {
+                    const float32x4_t xk = vdupq_n_f32(x[k + s]);
+                    const float* column = layer.weights + (k + s) * Stride;
+                    NEUROMAP_UNROLL
+                    for (int v = 0; v < Vectors; ++v)
+                        acc[s][v] = vfmaq_f32(acc[s][v], vld1q_f32(column + 4 * v), xk);
+                }
+            }
+            for (int k = Whole; k < N; ++k)
+            {
+                const float32x4_t xk = vdupq_n_f32(x[k]);
+                const float* column = layer.weights + k * Stride;
+                NEUROMAP_UNROLL
+                for (int v = 0; v < Vectors; ++v)
+                    acc[0][v] = vfmaq_f32(acc[0][v], vld1q_f32(column + 4 * v), xk);
+            }
+            NEUROMAP_UNROLL
+            for (int v = 0; v < Vectors; ++v)
+            {
+                NEUROMAP_UNROLL
+                for (int s = 1; s < Sums; ++s)
+                    acc[0][v] = vaddq_f32(acc[0][v], acc[s][v]);
+                vst1q_f32(y + 4 * v, Hidden && Fast ? fastTanhNEON(acc[0][v]) : acc[0][v]);
+            }
+            if (Hidden && !Fast)
+            {
+                for (int j = 0; j < M; ++j)
+                    y[j] = std::tanh(y[j]);
+            }
+        }
+    };
+#endif
+
+    // Layer sizes are template parameters so the layer loops unroll and the
+    // activations stay on the stack. Only the number of hidden-to-hidden
+    // layers is a runtime value.
+    template <template <int, int, bool, bool> class Columns, int In, int Hidden, int Out, bool Fast>
+    void forwardColumns(const DenseLayer* layers, int numLayers, const float* input, float* output, float*)
+    {
+        alignas(64) float a[InferenceKernels::columnStride(Hidden)];
+        alignas(64) float b[InferenceKernels::columnStride(Hidden)];
+        alignas(64) float y[InferenceKernels::columnStride(Out)];
+
+        Columns<In, Hidden, true, Fast>::apply(layers[0], input, a);
+
+        float* current = a;
+        float* next = b;
+        for (int l = 1; l < numLayers - 1; ++l)
+        {
+            Columns<Hidden, Hidden, true, Fast>::apply(layers[l], current, next);
+            std::swap(current, next);
+        }
+
+        Columns<Hidden, Out, false, false>::apply(layers[numLayers - 1], current, y);
+        for (int j = 0; j < Out; ++j)
+        {
+            output[j] = y[j];
+        }
+    }
+
+    template <template <int, int, bool, bool> class Columns, int In, int Hidden, bool Fast>
+    ForwardKernelFn selectForOutput(int outputDim)
+    {
+        switch (outputDim)
+        {
+            case 1: return &forwardColumns<Columns, In, Hidden, 1, Fast>;
+            case 2: return &forwardColumns<Columns, In, Hidden, 2, Fast>;
+            case 3: return &forwardColumns<Columns, In, Hidden, 3, Fast>;
+            case 4: return &forwardColumns<Columns, In, Hidden, 4, Fast>;
+            default: return nullptr;
+        }
+    }
+
+    template <template <int, int, bool, bool> class Columns, int In, bool Fast>
+    ForwardKernelFn selectForHidden(int hiddenUnits, int outputDim)
+    {
+        switch (hiddenUnits)
+        {
+            case 8: return selectForOutput<Columns, In, 8, Fast>(outputDim);
+            case 16: return selectForOutput<Columns, In, 16, Fast>(outputDim);
+            case 32: return selectForOutput<Columns, In, 32, Fast>(outputDim);
+            case 64: return selectForOutput<Columns, In, 64, Fast>(outputDim);
+            default: return nullptr;
+        }
+    }
+
+    template <template <int, int, bool, bool> class Columns, bool Fast>
+    ForwardKernelFn selectForInput(int inputDim, int hiddenUnits, int outputDim)
+    {
+        switch (inputDim)
+        {
+            case 1: return selectForHidden<Columns, 1, Fast>(hiddenUnits, outputDim);
+            case 2: return selectForHidden<Columns, 2, Fast>(hiddenUnits, outputDim);
+            case 3: return selectForHidden<Columns, 3, Fast>(hiddenUnits, outputDim);
+            case 4: return selectForHidden<Columns, 4, Fast>(hiddenUnits, outputDim);
+            default: return nullptr;
+        }
+    }
+
+    // Specialized shapes: 1-4 inputs, 8/16/32/64 hidden units, 1-4 outputs
+    template <template <int, int, bool, bool> class Columns>
+    ForwardKernelFn selectForward(int inputDim, int hiddenUnits, int outputDim, ActivationPrecision precision)
+    {
+        if (precision == ActivationPrecision::Fast)
+            return selectForInput<Columns, true>(inputDim, hiddenUnits, outputDim);
+        return selectForInput<Columns, false>(inputDim, hiddenUnits, outputDim);
+    }
+
+    using SimdKernels::Int8ZeroPoint;
+
+    inline int32_t load4(const uint8_t* p)
+    {
+        int32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    // Packed weights: each 16-row block is a run of [cols / 4][16][4], so
+    // one 64-byte load holds four columns of sixteen rows
+    void matMulInt8Scalar(const int8_t* packed, int rows, int cols, const uint8_t* x, int32_t* acc)
+    {
+        for (int block = 0; block < rows; block += 16)
+        {
+            const int8_t* w = packed + block * cols;
+            for (int s = 0; s < TileWidth; ++s)
+            {
+                const uint8_t* xs = x + s * cols;
+                int32_t sums[16] = {};
+                for (int k = 0; k < cols; k += 4)
+                {
+                    const int8_t* wk = w + k * 16;
+                    for (int r = 0; r < 16; ++r)
+                    {
+                        for (int i = 0; i < 4; ++i)
+                        {
+                            sums[r] += wk[r * 4 + i] * xs[k + i];
+                        }
+                    }
+                }
+                for (int r = 0; r < 16; ++r)
+                {
+                    acc[s * rows + block + r] = sums[r];
+                }
+            }
+        }
+    }
+
+    void dequantizeInt8Scalar(const int32_t* acc, int rows, const int32_t* correction,
+                              const float* scale, const float* bias, float* y, bool fastTanh)
+    {
+        for (int s = 0; s < TileWidth; ++s)
+        {
+            for (int j = 0; j < rows; ++j)
+            {
+                float value = static_cast<float>(acc[s * rows + j] + correction[j]) * scale[j] + bias[j];
+                y[s * rows + j] = fastTanh ? InferenceKernels::fastTanh(value) : value;
+            }
+        }
+    }
+
+    void quantizeInt8Scalar(const float* x, int count, float invScale, uint8_t* q)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            float value = std::max(-127.0f, std::min(127.0f, x[i] * invScale));
+            q[i] = static_cast<uint8_t>(static_cast<int>(std::nearbyint(value)) + Int8ZeroPoint);
+        }
+    }
+
+#ifdef NEUROMAP_X86
+    // The maddubs kernels sum u8 x s8 products in pairs into int16, which
+    // stays below saturation for weights within +-63; VNNI accumulates
+    // straight into int32 and takes the full int8 range
+    NEUROMAP_TARGET("sse4.1")
+    void matMulInt8SSE41(const int8_t* packed, int rows, int cols, const uint8_t* x, int32_t* acc)
+    {
+        const __m128i ones = _mm_set1_epi16(1);
+        for (int block = 0; block < rows; block += 16)
+        {
+            const int8_t* w = packed + block * cols;
+            for (int s = 0; s < TileWidth; s += 2)
+            {
+                const uint8_t* x0 = x + s * cols;
+                const uint8_t* x1 = x0 + cols;
+                __m128i sums0[4], sums1[4];
+                for (int r = 0; r < 4; ++r)
+                {
+                    sums0[r] = _mm_setzero_si128();
+                    sums1[r] = _mm_setzero_si128();
+                }
+                for (int k = 0; k < cols; k += 4)
+                {
+                    const __m128i* wk = reinterpret_cast<const __m128i*>(w + k * 16);
+                    const __m128i b0 = _mm_set1_epi32(load4(x0 + k));
+                    const __m128i b1 = _mm_set1_epi32(load4(x1 + k));
+                    for (int r = 0; r < 4; ++r)
+                    {
+                        const __m128i wr = _mm_loadu_si128(wk + r);
+                        sums0[r] = _mm_add_epi32(sums0[r], _mm_madd_epi16(_mm_maddubs_epi16(b0, wr), ones));
+                        sums1[r] = _mm_add_epi32(sums1[r], _mm_madd_epi16(_mm_maddubs_epi16(b1, wr), ones));
+                    }
+                }
+                for (int r = 0; r < 4; ++r)
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + s * rows + block + r * 4), sums0[r]);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + (s + 1) * rows + block + r * 4), sums1[r]);
+                }
+            }
+        }
+    }
+
+    NEUROMAP_TARGET("sse2")
+    void dequantizeInt8SSE(const int32_t* acc, int rows, const int32_t* correction,
+                           const float* scale, const float* bias, float* y, bool fastTanh)
+    {
+        for (int s = 0; s < TileWidth; ++s)
+        {
+            const int32_t* as = acc + s * rows;
+            float* ys = y + s * rows;
+            for (int j = 0; j < rows; j += 4)
+            {
+                const __m128i sum = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(as + j)),
+                                                  _mm_loadu_si128(reinterpret_cast<const __m128i*>(correction + j)));
+                __m128 value = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(sum), _mm_loadu_ps(scale + j)),
+                                          _mm_loadu_ps(bias + j));
+                if (fastTanh)
+                    value = fastTanhSSE(value);
+                _mm_storeu_ps(ys + j, value);
+            }
+        }
+    }
+
+    NEUROMAP_TARGET("sse2")
+    inline __m128i quantize4SSE(const float* x, __m128 invScale)
+    {
+        const __m128 value = _mm_max_ps(_mm_set1_ps(-127.0f),
+                                        _mm_min_ps(_mm_set1_ps(127.0f), _mm_mul_ps(_mm_loadu_ps(x), invScale)));
+        return _mm_add_epi32(_mm_cvtps_epi32(value), _mm_set1_epi32(Int8ZeroPoint));
+    }
+
+    NEUROMAP_TARGET("sse2")
+    void quantizeInt8SSE(const float* x, int count, float invScale, uint8_t* q)
+    {
+        const __m128 scale = _mm_set1_ps(invScale);
+        for (int i = 0; i < count; i += 16)
+        {
+            const __m128i lo = _mm_packs_epi32(quantize4SSE(x + i, scale), quantize4SSE(x + i + 4, scale));
+            const __m128i hi = _mm_packs_epi32(quantize4SSE(x + i + 8, scale), quantize4SSE(x + i + 12, scale));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(q + i), _mm_packus_epi16(lo, hi));
+        }
+    }
+
+    NEUROMAP_TARGET("avx2")
+    void matMulInt8AVX2(const int8_t* packed, int rows, int cols, const uint8_t* x, int32_t* acc)
+    {
+        const __m256i ones = _mm256_set1_epi16(1);
+        for (int block = 0; block < rows; block += 16)
+        {
+            // Eight rows per pass: the low or high half of each 64-byte group
+            for (int half = 0; half < 2; ++half)
+            {
+                const int8_t* w = packed + block * cols + half * 32;
+                for (int s = 0; s < TileWidth; s += 8)
+                {
+                    const uint8_t* xs = x + s * cols;
+                    __m256i sums[8];
+                    for (int i = 0; i < 8; ++i)
+                    {
+                        sums[i] = _mm256_setzero_si256();
+                    }
+                    for (int k = 0; k < cols; k += 4)
+                    {
+                        const __m256i wk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + k * 16));
+                        for (int i = 0; i < 8; ++i)
+                        {
+                            const __m256i b = _mm256_set1_epi32(load4(xs + i * cols + k));
+                            sums[i] = _mm256_add_epi32(sums[i], _mm256_madd_epi16(_mm256_maddubs_epi16(b, wk), ones));
+                        }
+                    }
+                    for (int i = 0; i < 8; ++i)
+                    {
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + (s + i) * rows + block + half * 8), sums[i]);
+                    }
+                }
+            }
+        }
+    }
+
+    NEUROMAP_TARGET("avx2,fma")
+    void dequantizeInt8AVX2(const int32_t* acc, int rows, const int32_t* correction,
+                            const float* scale, const float* bias, float* y, bool fastTanh)
+    {
+        for (int s = 0; s < TileWidth; ++s)
+        {
+            const int32_t* as = acc + s * rows;
+            float* ys = y + s * rows;
+            for (int j = 0; j < rows; j += 8)
+            {
+                const __m256i sum = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(as + j)),
+                                                     _mm256_loadu_si256(reinterpret_cast<const __m256i*>(correction + j)));
+                __m256 value = _mm256_fmadd_ps(_mm256_cvtepi32_ps(sum), _mm256_loadu_ps(scale + j),
+                                               _mm256_loadu_ps(bias + j));
+                if (fastTanh)
+                    value = fastTanhAVX2(value);
+                _mm256_storeu_ps(ys + j, value);
+            }
+        }
+    }
+
+    NEUROMAP_TARGET("avx2")
+    inline __m256i quantize8AVX2(const float* x, __m256 invScale)
+    {
+        const __m256 value = _mm256_max_ps(_mm256_set1_ps(-127.0f),
+                                           _mm256_min_ps(_mm256_set1_ps(127.0f), _mm256_mul_ps(_mm256_loadu_ps(x), invScale)));
+        return _mm256_add_epi32(_mm256_cvtps_epi32(value), _mm256_set1_epi32(Int8ZeroPoint));
+    }
+
+    NEUROMAP_TARGET("avx2")
+    void quantizeInt8AVX2(const float* x, int count, float invScale, uint8_t* q)
+    {
+        const __m256 scale = _mm256_set1_ps(invScale);
+        // The packs work within 128-bit lanes; the permute restores order
+        const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+        for (int i = 0; i < count; i += 32)
+        {
+            const __m256i ab = _mm256_packs_epi32(quantize8AVX2(x + i, scale), quantize8AVX2(x + i + 8, scale));
+            const __m256i cd = _mm256_packs_epi32(quantize8AVX2(x + i + 16, scale), quantize8AVX2(x + i + 24, scale));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(q + i),
+                                _mm256_permutevar8x32_epi32(_mm256_packus_epi16(ab, cd), order));
+        }
+    }
+
+    // Sixteen rows of a block against the whole tile, one accumulator per sample
+    NEUROMAP_TARGET("avx512f,avx512bw")
+    void matMulInt8AVX512(const int8_t* packed, int rows, int cols, const uint8_t* x, int32_t* acc)
+    {
+        const __m512i ones = _mm512_set1_epi16(1);
+        for (int block = 0; block < rows; block += 16)
+        {
+            const int8_t* w = packed + block * cols;
+            __m512i sums[TileWidth];
+            for (int s = 0; s < TileWidth; ++s)
+            {
+                sums[s] = _mm512_setzero_si512();
+            }
+            for (int k = 0; k < cols; k += 4)
+            {
+                const __m512i wk = _mm512_loadu_si512(w + k * 16);
+                for (int s = 0; s < TileWidth; ++s)
+                {
+                    const __m512i b = _mm512_set1_epi32(load4(x + s * cols + k));
+                    sums[s] = _mm512_add_epi32(sums[s], _mm512_madd_epi16(_mm512_maddubs_epi16(b, wk), ones));
+                }
+            }
+            for (int s = 0; s < TileWidth; ++s)
+            {
+                _mm512_storeu_si512(acc + s * rows + block, sums[s]);
+            }
+        }
+    }
+
+    NEUROMAP_TARGET("avx512f,avx512bw,avx512vnni")
+    void matMulInt8VNNI(const int8_t* packed, int rows, int cols, const uint8_t* x, int32_t* acc)
+    {
+        for (int block = 0; block < rows; block += 16)
+        {
+            const int8_t* w = packed + block * cols;
+            __m512i sums[TileWidth];
+            for (int s = 0; s < TileWidth; ++s)
+            {
+                sums[s] = _mm512_setzero_si512();
+            }
+            for (int k = 0; k < cols; k += 4)
+            {
+                const __m512i wk = _mm512_loadu_si512(w + k * 16);
+                for (int s = 0; s < TileWidth; ++s)
+                {
+                    sums[s] = _mm512_dpbusd_epi32(sums[s], _mm512_set1_epi32(load4(x + s * cols + k)), wk);
+                }
+            }
+            for (int s = 0; s < TileWidth; ++s)
+            {
+                _mm512_storeu_si512(acc + s * rows + block, sums[s]);
+            }
+        }
+    }
+
+    NEUROMAP_TARGET("avx512f")
+    void dequantizeInt8AVX512(const int32_t* acc, int rows, const int32_t* correction,
+                              const float* scale, const float* bias, float* y, bool fastTanh)
+    {
+        for (int s = 0; s < TileWidth; ++s)
+        {
+            const int32_t* as = acc + s * rows;
+            float* ys = y + s * rows;
+            for (int j = 0; j < rows; j += 16)
+            {
+                const __m512i sum = _mm512_add_epi32(_mm512_loadu_si512(as + j), _mm512_loadu_si512(correction + j));
+                __m512 value = _mm512_fmadd_ps(_mm512_cvtepi32_ps(sum), _mm512_loadu_ps(scale + j),
+                                               _mm512_loadu_ps(bias + j));
+                if (fastTanh)
+                    value = fastTanhAVX512(value);
+                _mm512_storeu_ps(ys + j, value);
+            }
+        }
+    }
+
+    NEUROMAP_TARGET("avx512f")
+    void quantizeInt8AVX512(const float* x, int count, float invScale, uint8_t* q)
+    {
+        const __m512 scale = _mm512_set1_ps(invScale);
+        const __m512 lo = _mm512_set1_ps(-127.0f);
+        const __m512 hi = _mm512_set1_ps(127.0f);
+        for (int i = 0; i < count; i += 16)
+        {
+            const __m512 value = _mm512_max_ps(lo, _mm512_min_ps(hi, _mm512_mul_ps(_mm512_loadu_ps(x + i), scale)));
+            const __m512i shifted = _mm512_add_epi32(_mm512_cvtps_epi32(value), _mm512_set1_epi32(Int8ZeroPoint));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(q + i), _mm512_cvtepi32_epi8(shifted));
+        }
+    }
+#endif
+
+#ifdef NEUROMAP_ARM64
+    void matMulInt8NEON(const int8_t* packed, int rows, int cols, const uint8_t* x, int32_t* acc)
+    {
+        for (int block = 0; block < rows; block += 16)
+        {
+            const int8_t* w = packed + block * cols;
+            for (int s = 0; s < TileWidth; ++s)
+            {
+                const uint8_t* xs = x + s * cols;
+                int32x4_t sums[4] = { vdupq_n_s32(0), vdupq_n_s32(0), vdupq_n_s32(0), vdupq_n_s32(0) };
+                for (int k = 0; k < cols; k += 4)
+                {
+                    // The four activations twice over, widened to int16
+                    const int16x8_t xk = vreinterpretq_s16_u16(
+                        vmovl_u8(vreinterpret_u8_s32(vdup_n_s32(load4(xs + k)))));
+                    for (int r = 0; r < 4; ++r)
+                    {
+                        // Four weights each of rows 4r..4r+3
+                        const int8x16_t wr = vld1q_s8(w + k * 16 + r * 16);
+                        const int16x8_t w01 = vmovl_s8(vget_low_s8(wr));
+                        const int16x8_t w23 = vmovl_high_s8(wr);
+                        const int32x4_t p0 = vmull_s16(vget_low_s16(w01), vget_low_s16(xk));
+                        const int32x4_t p1 = vmull_high_s16(w01, xk);
+                        const int32x4_t p2 = vmull_s16(vget_low_s16(w23), vget_low_s16(xk));
+                        const int32x4_t p3 = vmull_high_s16(w23, xk);
+                        sums[r] = vaddq_s32(sums[r], vpaddq_s32(vpaddq_s32(p0, p1), vpaddq_s32(p2, p3)));
+                    }
+                }
+                for (int r = 0; r < 4; ++r)
+                {
+                    vst1q_s32(acc + s * rows + block + r * 4, sums[r]);
+                }
+            }
+        }
+    }
+
+    void dequantizeInt8NEON(const int32_t* acc, int rows, const int32_t* correction,
+                            const float* scale, const float* bias, float* y, bool fastTanh)
+    {
+        for (int s = 0; s < TileWidth; ++s)
+        {
+            const int32_t* as = acc + s * rows;
+            float* ys = y + s * rows;
+            for (int j = 0; j < rows; j += 4)
+            {
+                const int32x4_t sum = vaddq_s32(vld1q_s32(as + j), vld1q_s32(correction + j));
+                float32x4_t value = vfmaq_f32(vld1q_f32(bias + j), vcvtq_f32_s32(sum), vld1q_f32(scale + j));
+                if (fastTanh)
+                    value = fastTanhNEON(value);
+                vst1q_f32(ys + j, value);
+            }
+        }
+    }
+
+    void quantizeInt8NEON(const float* x, int count, float invScale, uint8_t* q)
+    {
+        const float32x4_t lo = vdupq_n_f32(-127.0f);
+        const float32x4_t hi = vdupq_n_f32(127.0f);
+        const int32x4_t zeroPoint = vdupq_n_s32(Int8ZeroPoint);
+        for (int i = 0; i < count; i += 8)
+        {
+            const float32x4_t a = vmaxq_f32(lo, vminq_f32(hi, vmulq_n_f32(vld1q_f32(x + i), invScale)));
+            const float32x4_t b = vmaxq_f32(lo, vminq_f32(hi, vmulq_n_f32(vld1q_f32(x + i + 4), invScale)));
+            const int16x8_t shifted = vcombine_s16(vqmovn_s32(vaddq_s32(vcvtnq_s32_f32(a), zeroPoint)),
+                                                   vqmovn_s32(vaddq_s32(vcvtnq_s32_f32(b), zeroPoint)));
+            vst1_u8(q + i, vqmovun_s16(shifted));
+        }
+    }
+#endif
+
+    using SimdKernels::OneEuroStep;
+
+    const float TwoPi = 6.28318530717958647692f;
+
+    // dx = (x - v) / dt; d += aD * (dx - d); r = 2 pi dt (minCutoff + beta |d|);
+    // v += r / (r + 1) * (x - v)
+    void oneEuroScalar(float* x, float* value, float* derivative, int count, const OneEuroStep& step)
+    {
+        const float rate = 1.0f / step.dt;
+        const float omega = TwoPi * step.dt;
+        for (int i = 0; i < count; ++i)
+        {
+            const float delta = x[i] - value[i];
+            const float d = derivative[i] + step.derivativeAlpha * (delta * rate - derivative[i]);
+            const float r = omega * (step.minCutoff + step.beta * std::abs(d));
+            const float v = value[i] + r / (r + 1.0f) * delta;
+            derivative[i] = d;
+            value[i] = v;
+            x[i] = v;
+        }
+    }
+
+#ifdef NEUROMAP_X86
+    NEUROMAP_TARGET("sse2")
+    void oneEuroSSE(float* x, float* value, float* derivative, int count, const OneEuroStep& step)
+    {
+        const __m128 rate = _mm_set1_ps(1.0f / step.dt);
+        const __m128 omega = _mm_set1_ps(TwoPi * step.dt);
+        const __m128 minCutoff = _mm_set1_ps(step.minCutoff);
+        const __m128 beta = _mm_set1_ps(step.beta);
+        const __m128 alpha = _mm_set1_ps(step.derivativeAlpha);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128 v0 = _mm_loadu_ps(value + i);
+            const __m128 d0 = _mm_loadu_ps(derivative + i);
+            const __m128 delta = _mm_sub_ps(_mm_loadu_ps(x + i), v0);
+            const __m128 d = _mm_add_ps(d0, _mm_mul_ps(alpha, _mm_sub_ps(_mm_mul_ps(delta, rate), d0)));
+            const __m128 r = _mm_mul_ps(omega, _mm_add_ps(minCutoff, _mm_mul_ps(beta, _mm_andnot_ps(signMask, d))));
+            const __m128 v = _mm_add_ps(v0, _mm_mul_ps(_mm_div_ps(r, _mm_add_ps(r, one)), delta));
+            _mm_storeu_ps(derivative + i, d);
+            _mm_storeu_ps(value + i, v);
+            _mm_storeu_ps(x + i, v);
+        }
+        oneEuroScalar(x + i, value + i, derivative + i, count - i, step);
+    }
+
+    NEUROMAP_TARGET("avx2,fma")
+    void oneEuroAVX2(float* x, float* value, float* derivative, int count, const OneEuroStep& step)
+    {
+        const __m256 rate = _mm256_set1_ps(1.0f / step.dt);
+        const __m256 omega = _mm256_set1_ps(TwoPi * step.dt);
+        const __m256 minCutoff = _mm256_set1_ps(step.minCutoff);
+        const __m256 beta = _mm256_set1_ps(step.beta);
+        const __m256 alpha = _mm256_set1_ps(step.derivativeAlpha);
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+        int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256 v0 = _mm256_loadu_ps(value + i);
+            const __m256 d0 = _mm256_loadu_ps(derivative + i);
+            const __m256 delta = _mm256_sub_ps(_mm256_loadu_ps(x + i), v0);
+            const __m256 d = _mm256_fmadd_ps(alpha, _mm256_fmsub_ps(delta, rate, d0), d0);
+            const __m256 r = _mm256_mul_ps(omega, _mm256_fmadd_ps(beta, _mm256_andnot_ps(signMask, d), minCutoff));
+            const __m256 v = _mm256_fmadd_ps(_mm256_div_ps(r, _mm256_add_ps(r, one)), delta, v0);
+            _mm256_storeu_ps(derivative + i, d);
+            _mm256_storeu_ps(value + i, v);
+            _mm256_storeu_ps(x + i, v);
+        }
+        oneEuroScalar(x + i, value + i, derivative + i, count - i, step);
+    }
+#endif
+
+#ifdef NEUROMAP_ARM64
+    void oneEuroNEON(float* x, float* value, float* derivative, int count, const OneEuroStep& step)
+    {
+        const float32x4_t rate = vdupq_n_f32(1.0f / step.dt);
+        const float32x4_t omega = vdupq_n_f32(TwoPi * step.dt);
+        const float32x4_t minCutoff = vdupq_n_f32(step.minCutoff);
+        const float32x4_t beta = vdupq_n_f32(step.beta);
+        const float32x4_t alpha = vdupq_n_f32(step.derivativeAlpha);
+        const float32x4_t one = vdupq_n_f32(1.0f);
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            const float32x4_t v0 = vld1q_f32(value + i);
+            const float32x4_t d0 = vld1q_f32(derivative + i);
+            const float32x4_t delta = vsubq_f32(vld1q_f32(x + i), v0);
+            const float32x4_t d = vfmaq_f32(d0, alpha, vsubq_f32(vmulq_f32(delta, rate), d0));
+            const float32x4_t r = vmulq_f32(omega, vfmaq_f32(minCutoff, beta, vabsq_f32(d)));
+            const float32x4_t v = vfmaq_f32(v0, vdivq_f32(r, vaddq_f32(r, one)), delta);
+            vst1q_f32(derivative + i, d);
+            vst1q_f32(value + i, v);
+            vst1q_f32(x + i, v);
+        }
+        oneEuroScalar(x + i, value + i, derivative + i, count - i, step);
+    }
+#endif
+
+    struct Dispatch
+    {
+        SimdKernels::DenseTileFn dense;
+        SimdKernels::DenseTileFn denseFast;
+        SimdKernels::OneEuroFn oneEuro;
+        SimdKernels::SelectForwardFn forward;
+        const char* name;
+        SimdKernels::Int8Kernels int8;
+    };
+
+    Dispatch selectDispatch()
+    {
+        const CpuFeatures& cpu = CpuInfo::getFeatures();
+        (void)cpu;
+
+        Dispatch dispatch = { &denseTileScalar<false>, &denseTileScalar<true>, &oneEuroScalar,
+                              &selectForward<ColumnsScalar>, "Scalar",
+                              { &matMulInt8Scalar, &dequantizeInt8Scalar, &quantizeInt8Scalar, 127, "Scalar" } };
+
+#ifdef NEUROMAP_X86
+        if (cpu.avx512f)
+            dispatch = { &denseTileAVX512<false>, &denseTileAVX512<true>, &oneEuroAVX2,
+                         &selectForward<ColumnsAVX512>, "AVX-512", dispatch.int8 };
+        else if (cpu.avx2 && cpu.fma)
+            dispatch = { &denseTileAVX2<false>, &denseTileAVX2<true>, &oneEuroAVX2,
+                         &selectForward<ColumnsAVX2>, "AVX2", dispatch.int8 };
+        else if (cpu.sse2)
+            dispatch = { &denseTileSSE<false>, &denseTileSSE<true>, &oneEuroSSE,
+                         &selectForward<ColumnsSSE>, "SSE2", dispatch.int8 };
+
+        if (cpu.avx512bw && cpu.avx512vnni)
+            dispatch.int8 = { &matMulInt8VNNI, &dequantizeInt8AVX512, &quantizeInt8AVX512, 127, "AVX-512 VNNI" };
+        else if (cpu.avx512bw)
+            dispatch.int8 = { &matMulInt8AVX512, &dequantizeInt8AVX512, &quantizeInt8AVX512, 63, "AVX-512" };
+        else if (cpu.avx2 && cpu.fma)
+            dispatch.int8 = { &matMulInt8AVX2, &dequantizeInt8AVX2, &quantizeInt8AVX2, 63, "AVX2" };
+        else if (cpu.sse41)
+            dispatch.int8 = { &matMulInt8SSE41, &dequantizeInt8SSE, &quantizeInt8SSE, 63, "SSE4.1" };
+#endif
+#ifdef NEUROMAP_ARM64
+        if (cpu.neon)
+            dispatch = { &denseTileNEON<false>, &denseTileNEON<true>, &oneEuroNEON,
+                         &selectForward<ColumnsNEON>, "NEON",
+                         { &matMulInt8NEON, &dequantizeInt8NEON, &quantizeInt8NEON, 127, "NEON" } };
+#endif
+        return dispatch;
+    }
+
+    const Dispatch& getDispatch()
+    {
+        static const Dispatch dispatch = selectDispatch();
+        return dispatch;
+    }
+}
+
+namespace SimdKernels
+{
+
+DenseTileFn getDenseTileKernel(ActivationPrecision precision)
+{
+    return precision == ActivationPrecision::Fast ? getDispatch().denseFast : getDispatch().dense;
+}
+
+const Int8Kernels& getInt8Kernels()
+{
+    return getDispatch().int8;
+}
+
+ForwardKernelFn getForwardKernel(int inputDim, int hiddenUnits, int outputDim, ActivationPrecision precision)
+{
+    return getDispatch().forward(inputDim, hiddenUnits, outputDim, precision);
+}
+
+OneEuroFn getOneEuroKernel()
+{
+    return getDispatch().oneEuro;
+}
+
+const char* getKernelName()
+{
+    return getDispatch().name;
+}
+
+} // namespace SimdKernels
\ No newline at end of file
@@ -0,0 +1,74 @@
+/* TD-NeuroMap SIMD Kernels
+ * Batched dense-layer kernels with runtime CPU dispatch.
+ * Samples are processed in tiles laid out as [row][TileWidth], so each
+ * SIMD lane carries one sample and weights are broadcast across lanes.
+ */
+
+#pragma once
+
+#include "InferenceKernels.h"
+#include <cstdint>
+
+namespace SimdKernels
+{
+    // Samples per tile. A multiple of every supported vector width.
+    constexpr int TileWidth = 16;
+
+    // y[j][lane] = bias[j] + sum_k weights[j][k] * x[k][lane] over one tile,
+    // followed by tanh when 'hidden' is set. x and y are 64-byte aligned.
+    // Fast kernels apply the rational tanh in registers before the store.
+    typedef void (*DenseTileFn)(const DenseLayer& layer, const float* x, float* y, bool hidden);
+
+    // Int8 layers run on tiles of TileWidth samples laid out as
+    // [sample][dim]. Activations are uint8 holding int8 values offset by
+    // Int8ZeroPoint; weights are int8 packed in blocks of 16 rows, each a
+    // run of [cols / 4][16 rows][4 cols]. 'rows' is a multiple of 16 and
+    // 'cols' a multiple of 4.
+    constexpr int Int8ZeroPoint = 128;
+
+    // acc[s][j] = sum_k weights[j][k] * x[s][k], offset not removed
+    typedef void (*MatMulInt8Fn)(const int8_t* packed, int rows, int cols, const uint8_t* x, int32_t* acc);
+
+    // y[s][j] = (acc[s][j] + correction[j]) * scale[j] + bias[j] over a tile
+    // of 'rows' per sample, followed by the rational tanh when 'fastTanh'
+    typedef void (*DequantizeInt8Fn)(const int32_t* acc, int rows, const int32_t* correction,
+                                     const float* scale, const float* bias, float* y, bool fastTanh);
+
+    // q[i] = clamp(round(x[i] * invScale), -127, 127) + Int8ZeroPoint for
+    // 'count' values, a multiple of 64
+    typedef void (*QuantizeInt8Fn)(const float* x, int count, float invScale, uint8_t* q);
+
+    struct Int8Kernels
+    {
+        MatMulInt8Fn matMul;
+        DequantizeInt8Fn dequantize;
+        QuantizeInt8Fn quantize;
+        int weightLimit;        // Largest weight magnitude matMul accepts
+        const char* name;
+    };
+
+    // Per-step constants of a OneEuro filter bank
+    struct OneEuroStep
+    {
+        float dt;               // Seconds since the previous frame, > 0
+        float minCutoff;        // Hz
+        float beta;
+        float derivativeAlpha;  // Low-pass factor of the derivative for 'dt'
+    };
+
+    // One OneEuro step for 'count' independent channels stored SoA: x is
+    // filtered in place, 'value' and 'derivative' hold each channel's state.
+    typedef void (*OneEuroFn)(float* x, float* value, float* derivative, int count, const OneEuroStep& step);
+
+    // Returns the single-sample kernel specialized for this shape, or
+    // nullptr if it has none
+    typedef ForwardKernelFn (*SelectForwardFn)(int inputDim, int hiddenUnits, int outputDim,
+                                               ActivationPrecision precision);
+
+    // Best kernels for the running CPU, chosen once on first call
+    DenseTileFn getDenseTileKernel(ActivationPrecision precision);
+    ForwardKernelFn getForwardKernel(int inputDim, int hiddenUnits, int outputDim, ActivationPrecision precision);
+    const Int8Kernels& getInt8Kernels();
+    OneEuroFn getOneEuroKernel();
+    const char* getKernelName();
+}
\ No newline at end of file
@@ -0,0 +1,158 @@
+/* TD-NeuroMap Sparse Network Implementation */
+
+#include "SparseNetwork.h"
+#include "SimdKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+SparseNetwork::SparseNetwork(const NeuralNetwork& network)
+    : m_arch(network.getArchitecture())
+    , m_nonZeros(0)
+    , m_denseWeights(0)
+{
+    const DenseLayer* layers = network.getLayers();
+    m_layers.resize(network.getNumLayers());
+    for (int l = 0; l < network.getNumLayers(); ++l)
+    {
+        const DenseLayer& dense = layers[l];
+        SparseLayer& layer = m_layers[l];
+        layer.inputs = dense.inputs;
+        layer.outputs = dense.outputs;
+        layer.bias.assign(dense.bias, dense.bias + dense.outputs);
+        layer.rowStart.reserve(dense.outputs + 1);
+        layer.rowStart.push_back(0);
+
+        for (int j = 0; j < dense.outputs; ++j)
+        {
+            const float* row = dense.weights + j * dense.inputs;
+            for (int k = 0; k < dense.inputs; ++k)
+            {
+                if (row[k] != 0.0f)
+                {
+                    layer.columns.push_back(k);
+                    layer.values.push_back(row[k]);
+                }
+            }
+            layer.rowStart.push_back(static_cast<int32_t>(layer.values.size()));
+        }
+
+        m_nonZeros += layer.values.size();
+        m_denseWeights += static_cast<size_t>(dense.inputs) * dense.outputs;
+    }
+}
+
+void SparseNetwork::forward(const float* input, float* output, float* scratch,
+                            ActivationPrecision precision) const
+{
+    const int numLayers = static_cast<int>(m_layers.size());
+    const float* x = input;
+    float* current = scratch;
+    float* next = scratch + m_arch.hiddenUnits;
+
+    for (int l = 0; l < numLayers; ++l)
+    {
+        const SparseLayer& layer = m_layers[l];
+        const bool isOutput = l == numLayers - 1;
+        float* y = isOutput ? output : current;
+        for (int j = 0; j < layer.outputs; ++j)
+        {
+            float acc = layer.bias[j];
+            for (int p = layer.rowStart[j]; p < layer.rowStart[j + 1]; ++p)
+            {
+                acc += layer.values[p] * x[layer.columns[p]];
+            }
+            y[j] = isOutput ? acc : InferenceKernels::tanh(acc, precision);
+        }
+        x = current;
+        std::swap(current, next);
+    }
+}
+
+void SparseNetwork::forwardBatch(const float* const* inputs, float* const* outputs, int count, float* scratch,
+                                 ActivationPrecision precision) const
+{
+    const int tile = SimdKernels::TileWidth;
+    const int numLayers = static_cast<int>(m_layers.size());
+
+    float* xTile = scratch;
+    float* hiddenA = xTile + m_arch.inputDim * tile;
+    float* hiddenB = hiddenA + m_arch.hiddenUnits * tile;
+    float* yTile = hiddenB + m_arch.hiddenUnits * tile;
+
+    for (int base = 0; base < count; base += tile)
+    {
+        int lanes = std::min(tile, count - base);
+
+        for (int k = 0; k < m_arch.inputDim; ++k)
+        {
+            float* xk = xTile + k * tile;
+            const float* src = inputs[k] + base;
+            for (int lane = 0; lane < lanes; ++lane)
+            {
+                xk[lane] = src[lane];
+            }
+            for (int lane = lanes; lane < tile; ++lane)
+            {
+                xk[lane] = 0.0f;
+            }
+        }
+
+        const float* x = xTile;
+        float* current = hiddenA;
+        float* next = hiddenB;
+        for (int l = 0; l < numLayers - 1; ++l)
+        {
+            layerTile(m_layers[l], x, current, true, precision);
+            x = current;
+            std::swap(current, next);
+        }
+        layerTile(m_layers[numLayers - 1], x, yTile, false, precision);
+
+        for (int j = 0; j < m_arch.outputDim; ++j)
+        {
+            const float* yj = yTile + j * tile;
+            float* dst = outputs[j] + base;
+            for (int lane = 0; lane < lanes; ++lane)
+            {
+                dst[lane] = yj[lane];
+            }
+        }
+    }
+}
+
+int SparseNetwork::getBatchScratchSize() const
+{
+    return (m_arch.inputDim + 2 * m_arch.hiddenUnits + m_arch.outputDim) * SimdKernels::TileWidth;
+}
+
+void SparseNetwork::layerTile(const SparseLayer& layer, const float* x, float* y, bool hidden,
+                              ActivationPrecision precision)
+{
+    const int tile = SimdKernels::TileWidth;
+    for (int j = 0; j < layer.outputs; ++j)
+    {
+        float acc[SimdKernels::TileWidth];
+        for (int lane = 0; lane < tile; ++lane)
+        {
+            acc[lane] = layer.bias[j];
+        }
+
+        // Each surviving weight is broadcast across the tile's lanes
+        for (int p = layer.rowStart[j]; p < layer.rowStart[j + 1]; ++p)
+        {
+            const float w = layer.values[p];
+            const float* xk = x + layer.columns[p] * tile;
+            for (int lane = 0; lane < tile; ++lane)
+            {
+                acc[lane] += w * xk[lane];
+            }
+        }
+
+        float* yj = y + j * tile;
+        for (int lane = 0; lane < tile; ++lane)
+        {
+            yj[lane] = hidden ? InferenceKernels::tanh(acc[lane], precision) : acc[lane];
+        }
+    }
+}
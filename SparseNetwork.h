@@ -0,0 +1,51 @@
+/* TD-NeuroMap Sparse Network
+ * Compressed sparse row (CSR) copy of a magnitude-pruned NeuralNetwork.
+ * Only the surviving weights are stored and multiplied, so inference cost
+ * scales with the number of non-zeros rather than the layer sizes.
+ */
+
+#pragma once
+
+#include "NeuralNetwork.h"
+#include <cstdint>
+#include <vector>
+
+class SparseNetwork
+{
+public:
+    // Keeps every non-zero weight of 'network'
+    explicit SparseNetwork(const NeuralNetwork& network);
+
+    // Same contracts as NeuralNetwork::forward / forwardBatch
+    void forward(const float* input, float* output, float* scratch,
+                 ActivationPrecision precision = ActivationPrecision::Exact) const;
+    int getScratchSize() const { return 2 * m_arch.hiddenUnits; }
+    void forwardBatch(const float* const* inputs, float* const* outputs, int count, float* scratch,
+                      ActivationPrecision precision = ActivationPrecision::Exact) const;
+    int getBatchScratchSize() const;
+
+    size_t getNonZeros() const { return m_nonZeros; }
+    size_t getDenseWeights() const { return m_denseWeights; }
+
+    const NetworkArchitecture& getArchitecture() const { return m_arch; }
+
+private:
+    struct SparseLayer
+    {
+        int inputs;
+        int outputs;
+        std::vector<int32_t> rowStart;  // [outputs + 1] offsets into columns/values
+        std::vector<int32_t> columns;
+        std::vector<float> values;
+        std::vector<float> bias;
+    };
+
+    NetworkArchitecture m_arch;
+    std::vector<SparseLayer> m_layers;
+    size_t m_nonZeros;
+    size_t m_denseWeights;
+
+    // y[j][lane] over one SimdKernels tile; x and y are [row][TileWidth]
+    static void layerTile(const SparseLayer& layer, const float* x, float* y, bool hidden,
+                          ActivationPrecision precision);
+};
@@ -0,0 +1,308 @@
+/* TD-NeuroMap Trainer Implementation */
+
+#include "Trainer.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+namespace
+{
+    const float AdamBeta1 = 0.9f;
+    const float AdamBeta2 = 0.999f;
+    const float AdamEpsilon = 1e-8f;
+}
+
+Trainer::Trainer(NeuralNetwork& network, int numThreads)
+    : m_network(network)
+    , m_inputs(nullptr)
+    , m_targets(nullptr)
+    , m_batch(nullptr)
+    , m_batchCount(0)
+    , m_activeWorkers(1)
+    , m_activation(ActivationPrecision::Exact)
+    , m_generation(0)
+    , m_pending(0)
+    , m_stopping(false)
+{
+    const size_t storageSize = m_network.getStorageSize();
+    m_adamM.assign(storageSize, 0.0f);
+    m_adamV.assign(storageSize, 0.0f);
+
+    const int numLayers = m_network.getNumLayers();
+    const DenseLayer* layers = m_network.getLayers();
+
+    m_workers.resize(std::max(1, numThreads));
+    for (Worker& worker : m_workers)
+    {
+        worker.gradients.assign(storageSize, 0.0f);
+        worker.activations.resize(numLayers + 1);
+        worker.activations[0].resize(layers[0].inputs);
+        int widest = layers[0].inputs;
+        for (int l = 0; l < numLayers; ++l)
+        {
+            worker.activations[l + 1].resize(layers[l].outputs);
+            widest = std::max(widest, layers[l].outputs);
+        }
+        worker.delta.resize(widest);
+        worker.previousDelta.resize(widest);
+        worker.loss = 0.0;
+    }
+
+    // Worker 0 is the calling thread
+    for (int i = 1; i < static_cast<int>(m_workers.size()); ++i)
+    {
+        m_threads.emplace_back(&Trainer::workerLoop, this, i);
+    }
+}
+
+Trainer::~Trainer()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_start.notify_all();
+    for (std::thread& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void Trainer::setMask(const std::vector<uint8_t>& mask)
+{
+    m_mask = mask;
+}
+
+float Trainer::train(const Dataset& inputs, const Dataset& targets, const TrainingOptions& options)
+{
+    const int numSamples = static_cast<int>(std::min(inputs.size(), targets.size()));
+    if (numSamples == 0)
+    {
+        return 0.0f;
+    }
+
+    std::vector<int> order(numSamples);
+    std::iota(order.begin(), order.end(), 0);
+    std::mt19937 rng(options.seed);
+
+    m_activation = options.activation;
+    const int batchSize = std::max(1, options.batchSize);
+    int step = 0;
+    for (int epoch = 0; epoch < options.epochs; ++epoch)
+    {
+        std::shuffle(order.begin(), order.end(), rng);
+        for (int start = 0; start < numSamples; start += batchSize)
+        {
+            int count = std::min(batchSize, numSamples - start);
+            runBatch(inputs, targets, order.data() + start, count);
+            applyAdam(options.learningRate, ++step, count);
+        }
+    }
+
+    m_network.updateKernelWeights();
+    return evaluate(m_network, inputs, targets, options.activation);
+}
+
+float Trainer::evaluate(const NeuralNetwork& network, const Dataset& inputs, const Dataset& targets,
+                        ActivationPrecision precision)
+{
+    const int numSamples = static_cast<int>(std::min(inputs.size(), targets.size()));
+    if (numSamples == 0)
+    {
+        return 0.0f;
+    }
+
+    const int outputDim = network.getArchitecture().outputDim;
+    std::vector<float> output(outputDim);
+    std::vector<float> scratch(network.getScratchSize());
+
+    double total = 0.0;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        network.forward(inputs[i].data(), output.data(), scratch.data(), precision);
+        for (int j = 0; j < outputDim; ++j)
+        {
+            double diff = output[j] - targets[i][j];
+            total += diff * diff;
+        }
+    }
+    return static_cast<float>(total / (static_cast<double>(numSamples) * outputDim));
+}
+
+void Trainer::runBatch(const Dataset& inputs, const Dataset& targets, const int* batch, int count)
+{
+    m_inputs = &inputs;
+    m_targets = &targets;
+    m_batch = batch;
+    m_batchCount = count;
+
+    // Small batches are not worth waking the pool for
+    const int numWorkers = static_cast<int>(m_workers.size());
+    if (numWorkers == 1 || count < 2 * numWorkers)
+    {
+        m_activeWorkers = 1;
+        computeGradients(m_workers[0], 0, count);
+        return;
+    }
+
+    m_activeWorkers = numWorkers;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending = numWorkers - 1;
+        ++m_generation;
+    }
+    m_start.notify_all();
+
+    computeGradients(m_workers[0], 0, count / numWorkers);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_pending == 0; });
+}
+
+void Trainer::workerLoop(int index)
+{
+    uint64_t seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_start.wait(lock, [this, seen] { return m_stopping || m_generation != seen; });
+            if (m_stopping)
+            {
+                return;
+            }
+            seen = m_generation;
+        }
+
+        const int numWorkers = static_cast<int>(m_workers.size());
+        int begin = static_cast<int>(static_cast<int64_t>(m_batchCount) * index / numWorkers);
+        int end = static_cast<int>(static_cast<int64_t>(m_batchCount) * (index + 1) / numWorkers);
+        computeGradients(m_workers[index], begin, end);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_pending;
+        }
+        m_done.notify_one();
+    }
+}
+
+void Trainer::computeGradients(Worker& worker, int begin, int end)
+{
+    const int numLayers = m_network.getNumLayers();
+    const DenseLayer* layers = m_network.getLayers();
+    const float* storage = m_network.getStorage();
+
+    std::fill(worker.gradients.begin(), worker.gradients.end(), 0.0f);
+    worker.loss = 0.0;
+
+    for (int b = begin; b < end; ++b)
+    {
+        const std::vector<float>& input = (*m_inputs)[m_batch[b]];
+        const std::vector<float>& target = (*m_targets)[m_batch[b]];
+
+        // Forward pass, keeping every activation
+        std::copy(input.begin(), input.begin() + layers[0].inputs, worker.activations[0].begin());
+        for (int l = 0; l < numLayers; ++l)
+        {
+            const DenseLayer& layer = layers[l];
+            const float* x = worker.activations[l].data();
+            float* y = worker.activations[l + 1].data();
+            const bool hidden = l < numLayers - 1;
+            for (int j = 0; j < layer.outputs; ++j)
+            {
+                const float* row = layer.weights + j * layer.inputs;
+                float sum = layer.bias[j];
+                for (int k = 0; k < layer.inputs; ++k)
+                {
+                    sum += row[k] * x[k];
+                }
+                y[j] = hidden ? InferenceKernels::tanh(sum, m_activation) : sum;
+            }
+        }
+
+        // d(MSE)/d(output)
+        const DenseLayer& last = layers[numLayers - 1];
+        const float* output = worker.activations[numLayers].data();
+        const float scale = 2.0f / static_cast<float>(last.outputs);
+        for (int j = 0; j < last.outputs; ++j)
+        {
+            float diff = output[j] - target[j];
+            worker.loss += static_cast<double>(diff) * diff / last.outputs;
+            worker.delta[j] = scale * diff;
+        }
+
+        // Backward pass
+        for (int l = numLayers - 1; l >= 0; --l)
+        {
+            const DenseLayer& layer = layers[l];
+            const float* x = worker.activations[l].data();
+            float* gradWeights = worker.gradients.data() + (layer.weights - storage);
+            float* gradBias = worker.gradients.data() + (layer.bias - storage);
+
+            for (int j = 0; j < layer.outputs; ++j)
+            {
+                const float d = worker.delta[j];
+                float* gradRow = gradWeights + j * layer.inputs;
+                for (int k = 0; k < layer.inputs; ++k)
+                {
+                    gradRow[k] += d * x[k];
+                }
+                gradBias[j] += d;
+            }
+
+            if (l > 0)
+            {
+                // Propagate through W^T and the tanh derivative of the layer below
+                std::fill(worker.previousDelta.begin(), worker.previousDelta.begin() + layer.inputs, 0.0f);
+                for (int j = 0; j < layer.outputs; ++j)
+                {
+                    const float d = worker.delta[j];
+                    const float* row = layer.weights + j * layer.inputs;
+                    for (int k = 0; k < layer.inputs; ++k)
+                    {
+                        worker.previousDelta[k] += row[k] * d;
+                    }
+                }
+                for (int k = 0; k < layer.inputs; ++k)
+                {
+                    worker.previousDelta[k] *= 1.0f - x[k] * x[k];
+                }
+                std::swap(worker.delta, worker.previousDelta);
+            }
+        }
+    }
+}
+
+void Trainer::applyAdam(float learningRate, int step, int count)
+{
+    float* weights = m_network.getStorage();
+    const size_t size = m_network.getStorageSize();
+    const float invCount = 1.0f / static_cast<float>(count);
+    const float correction1 = 1.0f - std::pow(AdamBeta1, static_cast<float>(step));
+    const float correction2 = 1.0f - std::pow(AdamBeta2, static_cast<float>(step));
+    const bool masked = m_mask.size() == size;
+
+    // Padding slots never receive gradient and stay zero
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (masked && !m_mask[i])
+        {
+            continue;
+        }
+
+        float g = 0.0f;
+        for (int w = 0; w < m_activeWorkers; ++w)
+        {
+            g += m_workers[w].gradients[i];
+        }
+        g *= invCount;
+
+        m_adamM[i] = AdamBeta1 * m_adamM[i] + (1.0f - AdamBeta1) * g;
+        m_adamV[i] = AdamBeta2 * m_adamV[i] + (1.0f - AdamBeta2) * g * g;
+        float mHat = m_adamM[i] / correction1;
+        float vHat = m_adamV[i] / correction2;
+        weights[i] -= learningRate * mHat / (std::sqrt(vHat) + AdamEpsilon);
+    }
+}
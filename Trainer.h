@@ -0,0 +1,82 @@
+/* TD-NeuroMap Trainer
+ * Minibatch backpropagation with Adam on mean squared error. Each
+ * minibatch is split across a small pool of worker threads that
+ * accumulate gradients privately; the gradients are reduced before the
+ * update, so results do not depend on the thread count beyond float
+ * summation order.
+ */
+
+#pragma once
+
+#include "NeuralNetwork.h"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef std::vector<std::vector<float>> Dataset;   // [sample][dim]
+
+struct TrainingOptions
+{
+    int epochs = 100;
+    float learningRate = 0.001f;
+    int batchSize = 32;
+    uint32_t seed = 1;
+    ActivationPrecision activation = ActivationPrecision::Exact;   // Match the Run mode setting
+};
+
+class Trainer
+{
+public:
+    Trainer(NeuralNetwork& network, int numThreads);
+    ~Trainer();
+
+    // Weights whose mask entry is 0 (storage layout) are held at zero, so
+    // pruned connections stay pruned while the rest fine-tune
+    void setMask(const std::vector<uint8_t>& mask);
+
+    // Inputs and targets are in network space (normalized). Returns the
+    // MSE over the whole set after the last epoch.
+    float train(const Dataset& inputs, const Dataset& targets, const TrainingOptions& options);
+
+    static float evaluate(const NeuralNetwork& network, const Dataset& inputs, const Dataset& targets,
+                          ActivationPrecision precision = ActivationPrecision::Exact);
+
+private:
+    struct Worker
+    {
+        std::vector<float> gradients;                // Storage layout
+        std::vector<std::vector<float>> activations; // [layer][unit], layer 0 is the input
+        std::vector<float> delta;
+        std::vector<float> previousDelta;
+        double loss;
+    };
+
+    NeuralNetwork& m_network;
+    std::vector<uint8_t> m_mask;
+    std::vector<float> m_adamM;
+    std::vector<float> m_adamV;
+    std::vector<Worker> m_workers;
+
+    // Batch shared with the pool while a job is running
+    const Dataset* m_inputs;
+    const Dataset* m_targets;
+    const int* m_batch;
+    int m_batchCount;
+    int m_activeWorkers;    // Workers holding gradients for the current batch
+    ActivationPrecision m_activation;
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_start;
+    std::condition_variable m_done;
+    uint64_t m_generation;
+    int m_pending;
+    bool m_stopping;
+
+    void runBatch(const Dataset& inputs, const Dataset& targets, const int* batch, int count);
+    void workerLoop(int index);
+    void computeGradients(Worker& worker, int begin, int end);
+    void applyAdam(float learningRate, int step, int count);
+};
@@ -0,0 +1,83 @@
+/* TD-NeuroMap Upsampler Implementation */
+
+#include "Upsampler.h"
+#include <algorithm>
+
+Upsampler::Upsampler()
+    : m_numChannels(0)
+    , m_primed(false)
+{
+}
+
+void Upsampler::resize(int numChannels)
+{
+    if (numChannels != m_numChannels)
+    {
+        m_numChannels = numChannels;
+        m_previous.assign(numChannels, 0.0f);
+        m_tangent.assign(numChannels, 0.0f);
+        m_primed = false;
+    }
+}
+
+void Upsampler::render(const float* target, float* const* channels, int numSamples, UpsampleInterpolation mode)
+{
+    if (!m_primed)
+    {
+        std::copy(target, target + m_numChannels, m_previous.begin());
+        std::fill(m_tangent.begin(), m_tangent.end(), 0.0f);
+        m_primed = true;
+    }
+
+    if (numSamples <= 0)
+    {
+        return;
+    }
+
+    // Weights depend only on the sample position, so they are shared by
+    // every channel; t runs over (0, 1]
+    if (m_basis.size() < static_cast<size_t>(4 * numSamples))
+    {
+        m_basis.resize(4 * numSamples);
+    }
+    float* h00 = m_basis.data();
+    float* h10 = h00 + numSamples;
+    float* h01 = h10 + numSamples;
+    float* h11 = h01 + numSamples;
+    for (int s = 0; s < numSamples; ++s)
+    {
+        const float t = static_cast<float>(s + 1) / numSamples;
+        if (mode == UpsampleInterpolation::Cubic)
+        {
+            const float t2 = t * t;
+            const float t3 = t2 * t;
+            h00[s] = 2.0f * t3 - 3.0f * t2 + 1.0f;
+            h10[s] = t3 - 2.0f * t2 + t;
+            h01[s] = -2.0f * t3 + 3.0f * t2;
+            h11[s] = t3 - t2;
+        }
+        else
+        {
+            h00[s] = 1.0f - t;
+            h10[s] = 0.0f;
+            h01[s] = t;
+            h11[s] = 0.0f;
+        }
+    }
+
+    for (int c = 0; c < m_numChannels; ++c)
+    {
+        const float p0 = m_previous[c];
+        const float p1 = target[c];
+        const float m0 = m_tangent[c];
+        const float m1 = p1 - p0;
+        float* out = channels[c];
+        for (int s = 0; s < numSamples; ++s)
+        {
+            out[s] = h00[s] * p0 + h10[s] * m0 + h01[s] * p1 + h11[s] * m1;
+        }
+
+        m_previous[c] = p1;
+        m_tangent[c] = m1;
+    }
+}
@@ -0,0 +1,42 @@
+/* TD-NeuroMap Upsampler
+ * Renders the trajectory between successive frame-rate inference results
+ * as an audio-rate block, so downstream audio consumers get continuous
+ * control without running the network per audio sample.
+ */
+
+#pragma once
+
+#include <vector>
+
+enum class UpsampleInterpolation
+{
+    Linear = 0,
+    Cubic = 1
+};
+
+class Upsampler
+{
+public:
+    Upsampler();
+
+    // A different channel count restarts the trajectory
+    void resize(int numChannels);
+
+    // The next result is emitted as a constant block
+    void reset() { m_primed = false; }
+
+    // Takes the newest result 'target' and writes channels[c][0..numSamples)
+    // running from the previous result to it; the last sample lands on
+    // 'target'. Cubic is a Hermite spline whose tangent at each result is
+    // the step into it, so consecutive blocks join with matching slope.
+    void render(const float* target, float* const* channels, int numSamples, UpsampleInterpolation mode);
+
+    int getNumChannels() const { return m_numChannels; }
+
+private:
+    int m_numChannels;
+    bool m_primed;
+    std::vector<float> m_previous;      // Result the current block starts from
+    std::vector<float> m_tangent;       // Step into m_previous
+    std::vector<float> m_basis;         // [4][numSamples] Hermite weights, grow-only
+};
@@ -0,0 +1,85 @@
+/* TD-NeuroMap Fast Tanh Test
+ * Sweeps the Fast tanh across its clamped range, and past it, through the
+ * scalar form and the dense tile kernel dispatched for this CPU, and checks
+ * both stay within InferenceKernels::TanhMaxError of tanh.
+ */
+
+#include "InferenceKernels.h"
+#include "SimdKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+    // Evenly spaced points over [-Reach, Reach]; about every other float
+    // where the error peaks, near |x| = 5.8
+    const int SweepPoints = 1 << 24;
+
+    struct Worst
+    {
+        double error = 0.0;
+        float x = 0.0f;
+
+        void update(float input, float approx)
+        {
+            double e = std::fabs(static_cast<double>(approx) - std::tanh(static_cast<double>(input)));
+            if (e > error)
+            {
+                error = e;
+                x = input;
+            }
+        }
+    };
+
+    bool check(const char* name, const Worst& worst)
+    {
+        bool ok = worst.error <= InferenceKernels::TanhMaxError;
+        std::printf("%-28s %s: max error %.3g at %.7g (bound %.3g)\n", name, ok ? "ok" : "FAIL", worst.error,
+                    worst.x, static_cast<double>(InferenceKernels::TanhMaxError));
+        return ok;
+    }
+}
+
+int main()
+{
+    using SimdKernels::TileWidth;
+
+    // One input, one output, identity weight: the tile kernel's output is
+    // its tanh of each input lane
+    const float weight = 1.0f;
+    const float bias = 0.0f;
+    const DenseLayer layer = { 1, 1, &weight, &bias };
+    SimdKernels::DenseTileFn tile = SimdKernels::getDenseTileKernel(ActivationPrecision::Fast);
+    alignas(64) float x[TileWidth];
+    alignas(64) float y[TileWidth];
+
+    int failures = 0;
+    const float ranges[] = { InferenceKernels::TanhClamp, 16.0f };
+    const char* names[] = { "clamped range", "clamped range + saturation" };
+    for (int r = 0; r < 2; ++r)
+    {
+        const float reach = ranges[r];
+        Worst scalar, simd;
+        for (int base = 0; base <= SweepPoints; base += TileWidth)
+        {
+            for (int lane = 0; lane < TileWidth; ++lane)
+            {
+                int i = std::min(base + lane, SweepPoints);
+                x[lane] = -reach + 2.0f * reach * (static_cast<float>(i) / SweepPoints);
+            }
+            tile(layer, x, y, true);
+            for (int lane = 0; lane < TileWidth; ++lane)
+            {
+                scalar.update(x[lane], InferenceKernels::fastTanh(x[lane]));
+                simd.update(x[lane], y[lane]);
+            }
+        }
+
+        std::printf("%s, %s kernels\n", names[r], SimdKernels::getKernelName());
+        failures += check("  scalar", scalar) ? 0 : 1;
+        failures += check("  dense tile", simd) ? 0 : 1;
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,165 @@
+/* TD-NeuroMap Model File Test
+ * Round-trips a normalized model through a version 3 file, saved and then
+ * mapped, and through FluCoMa JSON, comparing outputs with the original;
+ * checks that a flipped byte fails the checksum and that JSON weights are
+ * read as [input][output] into the network's [output][input] layout.
+ */
+
+#include "ModelFile.h"
+#include "FluCoMaModel.h"
+#include "MappedFile.h"
+#include "NormalizationFold.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const int NumInputs = 64;
+
+    // Largest output difference of two networks over the same random
+    // inputs drawn from [lower, upper]
+    double maxDifference(const NeuralNetwork& a, const NeuralNetwork& b, float lower, float upper)
+    {
+        const NetworkArchitecture& arch = a.getArchitecture();
+        std::vector<float> input(arch.inputDim), outA(arch.outputDim), outB(arch.outputDim);
+        std::vector<float> scratch(std::max(a.getScratchSize(), b.getScratchSize()));
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> dist(lower, upper);
+        double worst = 0.0;
+        for (int n = 0; n < NumInputs; ++n)
+        {
+            for (float& v : input)
+                v = dist(rng);
+            a.forward(input.data(), outA.data(), scratch.data());
+            b.forward(input.data(), outB.data(), scratch.data());
+            for (int j = 0; j < arch.outputDim; ++j)
+                worst = std::max(worst, std::fabs(static_cast<double>(outA[j]) - outB[j]));
+        }
+        return worst;
+    }
+
+    bool check(const char* name, bool ok, const std::string& detail)
+    {
+        std::printf("%-28s %s: %s\n", name, ok ? "ok" : "FAIL", detail.c_str());
+        return ok;
+    }
+
+    std::string describe(double difference)
+    {
+        char text[64];
+        std::snprintf(text, sizeof(text), "max output difference %.3g", difference);
+        return text;
+    }
+}
+
+int main()
+{
+    int failures = 0;
+
+    NetworkArchitecture arch;
+    arch.inputDim = 3;
+    arch.outputDim = 2;
+    arch.hiddenUnits = 16;
+    arch.hiddenLayers = 2;
+    NeuralNetwork network(arch);
+    network.initializeWeights(7);
+
+    NormalizationBounds bounds;
+    bounds.inputMin = { -2.0f, 0.0f, 10.0f };
+    bounds.inputMax = { 2.0f, 1.0f, 30.0f };
+    bounds.outputMin = { -1.0f, 100.0f };
+    bounds.outputMax = { 1.0f, 400.0f };
+    std::shared_ptr<const NeuralNetwork> folded = NormalizationFold::makeFolded(network, bounds);
+
+    // Version 3: save, map, parse. The file stores the folded form, so the
+    // network-space model comes back through unfolding and matches closely
+    // rather than exactly.
+    const std::string path = "model_file_test.nmap";
+    std::string error;
+    if (!ModelFile::save(path, network, bounds, error))
+    {
+        std::printf("Cannot write test model: %s\n", error.c_str());
+        return 1;
+    }
+    std::shared_ptr<MappedFile> file = MappedFile::open(path, error);
+    NormalizationBounds loadedBounds;
+    std::unique_ptr<NeuralNetwork> loadedFolded;
+    std::unique_ptr<NeuralNetwork> loaded =
+        file ? ModelFile::parse(file, loadedBounds, loadedFolded, error) : nullptr;
+    file.reset();
+    std::remove(path.c_str());
+    if (!loaded || !loadedFolded)
+    {
+        std::printf("FAIL: model did not load: %s\n", error.c_str());
+        return 1;
+    }
+
+    bool boundsMatch = loadedBounds.inputMin == bounds.inputMin && loadedBounds.inputMax == bounds.inputMax &&
+                       loadedBounds.outputMin == bounds.outputMin && loadedBounds.outputMax == bounds.outputMax;
+    failures += check("v3 bounds", boundsMatch && loaded->getArchitecture() == arch,
+                      boundsMatch ? "architecture and bounds read back" : "bounds differ") ? 0 : 1;
+    double networkDifference = maxDifference(network, *loaded, 0.0f, 1.0f);
+    failures += check("v3 network space", networkDifference < 1e-4, describe(networkDifference)) ? 0 : 1;
+    double foldedDifference = maxDifference(*folded, *loadedFolded, -2.0f, 30.0f);
+    failures += check("v3 folded", foldedDifference == 0.0, describe(foldedDifference)) ? 0 : 1;
+
+    // Every byte after the checksum field is covered by it; flipping one
+    // anywhere there must fail the load
+    std::vector<char> bytes;
+    ModelFile::serialize(network, bounds, bytes);
+    int accepted = 0;
+    int flipped = 0;
+    for (size_t at = 16; at < bytes.size(); at += 7, ++flipped)
+    {
+        std::vector<char> corrupt = bytes;
+        corrupt[at] ^= 0x10;
+        NormalizationBounds ignored;
+        std::unique_ptr<NeuralNetwork> ignoredFolded;
+        if (ModelFile::parse(corrupt, ignored, ignoredFolded, error) ||
+            error.find("checksum") == std::string::npos)
+        {
+            ++accepted;
+        }
+    }
+    failures += check("v3 flipped byte", accepted == 0,
+                      std::to_string(flipped - accepted) + " of " + std::to_string(flipped) +
+                      " corrupted copies rejected by the checksum") ? 0 : 1;
+
+    // FluCoMa stores weights[row = input][col = output]
+    const std::string json =
+        "{\"layers\":[{\"activation\":3,\"biases\":[0.5,-0.5,0.25],\"cols\":3,\"rows\":2,"
+        "\"weights\":[[1,2,3],[4,5,6]]},{\"activation\":0,\"biases\":[0.125],\"cols\":1,\"rows\":3,"
+        "\"weights\":[[0.5],[-1],[2]]}]}";
+    std::unique_ptr<NeuralNetwork> imported = FluCoMaModel::parse(json.data(), json.size(), error);
+    bool transposed = false;
+    if (imported && imported->getArchitecture().inputDim == 2 && imported->getArchitecture().hiddenUnits == 3)
+    {
+        const float expected[] = { 1.0f, 4.0f, 2.0f, 5.0f, 3.0f, 6.0f };
+        transposed = std::equal(expected, expected + 6, imported->getLayers()[0].weights);
+    }
+    failures += check("FluCoMa import transpose", transposed,
+                      imported ? "weights[input][output] stored as [output][input]" : error) ? 0 : 1;
+
+    std::vector<char> exported;
+    if (imported)
+    {
+        FluCoMaModel::serialize(*imported, NormalizationBounds(), exported);
+    }
+    failures += check("FluCoMa export transpose", std::string(exported.begin(), exported.end()) == json,
+                      "re-export matches the imported text") ? 0 : 1;
+
+    // Export folds the bounds in; floats are written with enough digits to
+    // read back exactly, so the import runs the same weights
+    FluCoMaModel::serialize(network, bounds, exported);
+    std::unique_ptr<NeuralNetwork> reimported = FluCoMaModel::parse(exported.data(), exported.size(), error);
+    double jsonDifference = reimported ? maxDifference(*folded, *reimported, -2.0f, 30.0f) : HUGE_VAL;
+    failures += check("FluCoMa round trip", jsonDifference == 0.0,
+                      reimported ? describe(jsonDifference) : error) ? 0 : 1;
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,414 @@
+/* TD-NeuroMap Run Allocation Test
+ * Drives the CHOP through steady-state Run cooks and checks that none of
+ * them allocates. Global operator new/delete are replaced to count every
+ * heap allocation made while a cook runs.
+ */
+
+#include "NeuroMapCHOP.h"
+#include "ModelFile.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    std::atomic<long> g_allocations(0);
+    std::atomic<bool> g_counting(false);
+
+    void* allocate(std::size_t size)
+    {
+        if (g_counting)
+        {
+            ++g_allocations;
+        }
+        void* p = std::malloc(size ? size : 1);
+        if (!p)
+        {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+}
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return std::malloc(size ? size : 1); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return std::malloc(size ? size : 1); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace
+{
+    // Parameters and the first input of a node; everything else is absent
+    class TestInputs : public OP_Inputs
+    {
+    public:
+        // Transparent comparison, so lookups by name construct no string
+        std::map<std::string, double, std::less<>> pars;
+        std::map<std::string, std::string, std::less<>> strings;
+        OP_CHOPInput input;
+        OP_TimeInfo time;
+
+        TestInputs()
+            : input()
+            , time()
+        {
+            time.rate = 60.0;
+            time.deltaFrames = 1.0;
+        }
+
+        int32_t getNumInputs() const override { return 1; }
+        const OP_TOPInputOpenGL* getInputTOPOpenGL(int32_t) const override { return nullptr; }
+        const OP_CHOPInput* getInputCHOP(int32_t index) const override { return index == 0 ? &input : nullptr; }
+        const OP_DATInput* getParDAT(const char*) const override { return nullptr; }
+        const OP_TOPInputOpenGL* getParTOPOpenGL(const char*) const override { return nullptr; }
+        const OP_CHOPInput* getParCHOP(const char*) const override { return nullptr; }
+        const OP_ObjectInput* getParObject(const char*) const override { return nullptr; }
+        double getParDouble(const char* name, int32_t = 0) const override { return value(name); }
+        bool getParDouble2(const char*, double&, double&) const override { return false; }
+        bool getParDouble3(const char*, double&, double&, double&) const override { return false; }
+        bool getParDouble4(const char*, double&, double&, double&, double&) const override { return false; }
+        int32_t getParInt(const char* name, int32_t = 0) const override { return static_cast<int32_t>(value(name)); }
+        bool getParInt2(const char*, int32_t&, int32_t&) const override { return false; }
+        bool getParInt3(const char*, int32_t&, int32_t&, int32_t&) const override { return false; }
+        bool getParInt4(const char*, int32_t&, int32_t&, int32_t&, int32_t&) const override { return false; }
+        const char* getParString(const char* name) const override
+        {
+            auto it = strings.find(name);
+            return it == strings.end() ? "" : it->second.c_str();
+        }
+        const char* getParFilePath(const char* name) const override { return getParString(name); }
+        bool getRelativeTransform(const char*, const char*, double[4][4]) const override { return false; }
+        void enablePar(const char*, bool) const override {}
+        const OP_DATInput* getDAT(const char*) const override { return nullptr; }
+        const OP_TOPInputOpenGL* getTOPOpenGL(const char*) const override { return nullptr; }
+        const OP_CHOPInput* getCHOP(const char*) const override { return nullptr; }
+        const OP_ObjectInput* getObject(const char*) const override { return nullptr; }
+        void* getTOPDataInCPUMemory(const OP_TOPInputOpenGL*, const OP_TOPInputDownloadOptionsOpenGL*) const override
+        {
+            return nullptr;
+        }
+        const OP_SOPInput* getParSOP(const char*) const override { return nullptr; }
+        const OP_SOPInput* getInputSOP(int32_t) const override { return nullptr; }
+        const OP_SOPInput* getSOP(const char*) const override { return nullptr; }
+        const OP_DATInput* getInputDAT(int32_t) const override { return nullptr; }
+        PyObject* getParPython(const char*) const override { return nullptr; }
+        const OP_TimeInfo* getTimeInfo() const override { return &time; }
+        const OP_TOPInput* getTOP(const char*) const override { return nullptr; }
+        const OP_TOPInput* getInputTOP(int32_t) const override { return nullptr; }
+        const OP_TOPInput* getParTOP(const char*) const override { return nullptr; }
+
+    private:
+        double value(const char* name) const
+        {
+            auto it = pars.find(name);
+            return it == pars.end() ? 0.0 : it->second;
+        }
+    };
+
+    // Owns the input channels fed to the node and the output TouchDesigner
+    // would allocate from getOutputInfo
+    class Harness
+    {
+    public:
+        Harness(NeuroMapCHOP& chop, TestInputs& inputs)
+            : m_chop(chop)
+            , m_inputs(inputs)
+            , m_frame(0)
+        {
+        }
+
+        void setInput(int numChannels, int numSamples)
+        {
+            m_inputData.assign(static_cast<size_t>(numChannels) * numSamples, 0.0f);
+            m_inputChannels.resize(numChannels);
+            for (int c = 0; c < numChannels; ++c)
+            {
+                m_inputChannels[c] = m_inputData.data() + static_cast<size_t>(c) * numSamples;
+            }
+            m_inputs.input.numChannels = numChannels;
+            m_inputs.input.numSamples = numSamples;
+            m_inputs.input.sampleRate = 60.0;
+            m_inputs.input.channelData = m_inputChannels.data();
+        }
+
+        // One cook the way TouchDesigner runs it. The output is allocated
+        // outside the counted region, as TouchDesigner owns it.
+        void cook(bool count)
+        {
+            // New values every cook, so the cached result is never reused
+            ++m_frame;
+            for (size_t i = 0; i < m_inputData.size(); ++i)
+            {
+                m_inputData[i] = static_cast<float>((i * 7 + m_frame * 13) % 101) / 100.0f;
+            }
+
+            CHOP_OutputInfo info = {};
+            info.numChannels = m_inputs.input.numChannels;
+            info.numSamples = m_inputs.input.numSamples;
+            info.sampleRate = 60.0f;
+            CHOP_GeneralInfo general = {};
+
+            g_counting = count;
+            m_chop.getGeneralInfo(&general, &m_inputs, nullptr);
+            m_chop.getOutputInfo(&info, &m_inputs, nullptr);
+            g_counting = false;
+
+            if (info.numChannels != static_cast<int>(m_outputChannels.size()) ||
+                info.numChannels * info.numSamples != static_cast<int>(m_outputData.size()))
+            {
+                m_outputData.assign(static_cast<size_t>(info.numChannels) * info.numSamples, 0.0f);
+                m_outputChannels.resize(info.numChannels);
+                for (int c = 0; c < info.numChannels; ++c)
+                {
+                    m_outputChannels[c] = m_outputData.data() + static_cast<size_t>(c) * info.numSamples;
+                }
+            }
+            CHOP_Output output(info.numChannels, info.numSamples, info.sampleRate, info.startIndex,
+                               m_outputChannels.data(), nullptr);
+
+            g_counting = count;
+            m_chop.execute(&output, &m_inputs, nullptr);
+            g_counting = false;
+        }
+
+        float infoChannel(const char* name)
+        {
+            for (int i = 0; i < m_chop.getNumInfoCHOPChans(nullptr); ++i)
+            {
+                OP_InfoCHOPChan chan = {};
+                TestString chanName;
+                chan.name = &chanName;
+                m_chop.getInfoCHOPChan(i, &chan, nullptr);
+                if (chanName.value == name)
+                {
+                    return chan.value;
+                }
+            }
+            return -1.0f;
+        }
+
+        // Background jobs finish on the worker and are applied by a later
+        // cook, which sizes its output before applying them; one more cook
+        // reports the new shape
+        void cookUntilIdle()
+        {
+            for (int i = 0; i < 1000; ++i)
+            {
+                cook(false);
+                if (infoChannel("file_jobs_pending") == 0.0f)
+                {
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+            cook(false);
+        }
+
+        int outputChannels() const { return static_cast<int>(m_outputChannels.size()); }
+
+    private:
+        class TestString : public OP_String
+        {
+        public:
+            void setString(const char* s) override { value = s; }
+            std::string value;
+        };
+
+        NeuroMapCHOP& m_chop;
+        TestInputs& m_inputs;
+        long m_frame;
+        std::vector<float> m_inputData;
+        std::vector<const float*> m_inputChannels;
+        std::vector<float> m_outputData;
+        std::vector<float*> m_outputChannels;
+    };
+
+    const int InputDim = 2;
+    const int OutputDim = 3;
+
+    struct Scenario
+    {
+        const char* name;
+        std::map<std::string, double> pars;
+        int numChannels;
+        int numSamples;
+        int expectedOutputChannels;
+    };
+
+    bool writeModel(const std::string& path)
+    {
+        NetworkArchitecture arch;
+        arch.inputDim = InputDim;
+        arch.outputDim = OutputDim;
+        arch.hiddenLayers = 2;
+        arch.hiddenUnits = 32;
+        NeuralNetwork network(arch);
+        network.initializeWeights(7);
+
+        NormalizationBounds bounds;
+        bounds.inputMin.assign(InputDim, 0.0f);
+        bounds.inputMax.assign(InputDim, 1.0f);
+        bounds.outputMin.assign(OutputDim, -2.0f);
+        bounds.outputMax.assign(OutputDim, 2.0f);
+
+        std::string error;
+        if (!ModelFile::save(path, network, bounds, error))
+        {
+            std::printf("Cannot write test model: %s\n", error.c_str());
+            return false;
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    const std::string modelPath = "run_allocation_test.nmap";
+    if (!writeModel(modelPath))
+    {
+        return 1;
+    }
+
+    OP_NodeInfo nodeInfo = {};
+    nodeInfo.opPath = "/test/neuromap1";
+    NeuroMapCHOP chop(&nodeInfo);
+    TestInputs inputs;
+    Harness harness(chop, inputs);
+
+    inputs.pars[InDimName] = InputDim;
+    inputs.pars[OutDimName] = OutputDim;
+    inputs.pars[ModeName] = static_cast<int>(ModeMenuItems::Run);
+    inputs.pars[MinCutoffName] = 1.0;
+    inputs.pars[BetaName] = 0.1;
+    inputs.pars[LutResolutionName] = 64;
+    inputs.strings[ModelFileName] = modelPath;
+    harness.setInput(InputDim, 1);
+
+    chop.pulsePressed(LoadModelName, nullptr);
+    harness.cookUntilIdle();
+    if (harness.outputChannels() != OutputDim)
+    {
+        std::printf("FAIL: model did not load\n");
+        return 1;
+    }
+
+    chop.pulsePressed(BakeLutName, nullptr);
+    harness.cookUntilIdle();
+    if (harness.infoChannel("lut_resolution") <= 0.0f)
+    {
+        std::printf("FAIL: LUT did not bake\n");
+        return 1;
+    }
+
+    const Scenario scenarios[] = {
+        { "single sample", {}, InputDim, 1, OutputDim },
+        { "chunked timeslice", {}, InputDim, 1000, OutputDim },
+        { "instances", { { InstanceModeName, static_cast<int>(InstanceModeMenuItems::Channelgroups) } },
+          InputDim * 40, 1, OutputDim * 40 },
+        { "instance samples", { { InstanceModeName, static_cast<int>(InstanceModeMenuItems::Samples) } },
+          InputDim, 300, OutputDim * 300 },
+        { "jacobian", { { JacobianName, 1 } }, InputDim, 600, OutputDim + OutputDim * InputDim },
+        { "smoothing", { { SmoothEnableName, 1 } }, InputDim, 600, OutputDim },
+        { "smoothed instances", { { SmoothEnableName, 1 },
+                                  { InstanceModeName, static_cast<int>(InstanceModeMenuItems::Channelgroups) } },
+          InputDim * 40, 1, OutputDim * 40 },
+        { "fast activation", { { ActivationName, static_cast<int>(ActivationMenuItems::Fast) } },
+          InputDim, 1000, OutputDim },
+        { "int8", { { PrecisionName, static_cast<int>(PrecisionMenuItems::Int8) } }, InputDim, 1000, OutputDim },
+        { "baked lut", { { RunSourceName, static_cast<int>(RunSourceMenuItems::Lut) } }, InputDim, 1000, OutputDim },
+    };
+
+    int failures = 0;
+    for (const Scenario& scenario : scenarios)
+    {
+        std::map<std::string, double, std::less<>> saved = inputs.pars;
+        for (const auto& par : scenario.pars)
+        {
+            inputs.pars[par.first] = par.second;
+        }
+        harness.setInput(scenario.numChannels, scenario.numSamples);
+
+        // Warm-up cooks may size buffers for the new shape and install
+        // models built in the background
+        harness.cookUntilIdle();
+        for (int i = 0; i < 3; ++i)
+        {
+            harness.cook(false);
+        }
+
+        g_allocations = 0;
+        for (int i = 0; i < 20; ++i)
+        {
+            harness.cook(true);
+        }
+        long allocations = g_allocations;
+
+        bool shapeOk = harness.outputChannels() == scenario.expectedOutputChannels;
+        bool ok = shapeOk && allocations == 0;
+        std::printf("%-20s %s: %ld allocations in 20 cooks, %d output channels\n", scenario.name,
+                    ok ? "ok" : "FAIL", allocations, harness.outputChannels());
+        failures += ok ? 0 : 1;
+
+        inputs.pars = saved;
+    }
+
+    // Bank slots keep their own int8 model and LUT, so switching between
+    // them swaps pointers only
+    const std::string bankPath = "run_allocation_test.nmbk";
+    inputs.pars[PrecisionName] = static_cast<int>(PrecisionMenuItems::Int8);
+    inputs.pars[RunSourceName] = static_cast<int>(RunSourceMenuItems::Lut);
+    inputs.strings[BankFileName] = bankPath;
+    harness.setInput(InputDim, 1000);
+    for (int slot = 0; slot < 2; ++slot)
+    {
+        inputs.pars[BankIndexName] = slot;
+        harness.cookUntilIdle();
+        chop.pulsePressed(StoreInBankName, nullptr);
+        harness.cook(false);
+    }
+    auto switchSlots = [&](const char* name)
+    {
+        g_allocations = 0;
+        for (int i = 0; i < 20; ++i)
+        {
+            inputs.pars[BankIndexName] = i % 2;
+            harness.cook(true);
+        }
+        long allocations = g_allocations;
+        bool ok = allocations == 0 && harness.infoChannel("bank_slot") == 1.0f &&
+                  harness.infoChannel("lut_resolution") > 0.0f;
+        std::printf("%-20s %s: %ld allocations in 20 cooks, slot %g\n", name, ok ? "ok" : "FAIL", allocations,
+                    harness.infoChannel("bank_slot"));
+        failures += ok ? 0 : 1;
+    };
+    switchSlots("bank switch");
+
+    // A model installed another way keeps serving until the index moves
+    chop.pulsePressed(LoadModelName, nullptr);
+    harness.cookUntilIdle();
+    bool kept = harness.infoChannel("bank_slot") == -1.0f;
+    std::printf("%-20s %s: slot %g after loading a model\n", "bank keeps install", kept ? "ok" : "FAIL",
+                harness.infoChannel("bank_slot"));
+    failures += kept ? 0 : 1;
+
+    // A loaded bank comes with the forms the current settings use
+    chop.pulsePressed(SaveBankName, nullptr);
+    harness.cookUntilIdle();
+    chop.pulsePressed(LoadBankName, nullptr);
+    harness.cookUntilIdle();
+    switchSlots("loaded bank switch");
+
+    std::remove(bankPath.c_str());
+    std::remove(modelPath.c_str());
+    return failures == 0 ? 0 : 1;
+}